@@ -0,0 +1,339 @@
+/*******************************************************************************************
+*
+*   raylib maze autoplay
+*
+*   Plays maze games headless, no window or input devices required: game simulation runs
+*   at a fixed step rate as fast as possible, player input given by a bot or a script
+*
+*   Bots:
+*       field   - Walks the shortest path to the nearest end cell (goal distance field)
+*       random  - Random moves (2D) or random walk and turns (3D), fixed seed
+*       script  - Inputs read from a script file (-i), one line per input:
+*                     ticks moveX moveY [walkX walkY lookX lookY]
+*                 input is repeated for ticks steps, lines starting with # are comments,
+*                 script is restarted when finished
+*
+*   One game is played for every seed (until end cell reached or time limit),
+*   reports result, steps and score for every game, and steps simulated per second
+*
+*   Build (raylib installed):
+*       gcc -O2 maze_autoplay.c -o maze_autoplay -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   Usage:
+*       maze_autoplay [-s first[:last]] [-w width] [-h height] [-m 2d|3d] [-b field|random|script]
+*                     [-i scriptFile] [-r stepRate] [-q]
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#define MAZE_GRID_IMPLEMENTATION
+#include "maze_grid.h"                  // Required for: MazeGrid
+#define MAZE_FIELD_IMPLEMENTATION
+#include "maze_field.h"                 // Required for: DistanceField, used by field bot
+#define MAZE_THREAD_IMPLEMENTATION
+#include "maze_thread.h"                // Required for: MazeThread, used by tiled maze generator, GetMazeThreadTime()
+#define MAZE_GEN_IMPLEMENTATION
+#include "maze_gen.h"                   // Required for: GenMazeGridTiled()
+#define MAZE_ITEMS_IMPLEMENTATION
+#include "maze_items.h"                 // Required for: SetCollectibleItems(), used by game simulation
+#define MAZE_COLLISION_IMPLEMENTATION
+#include "maze_collision.h"             // Required for: MoveMazeCircle(), used by game simulation
+#define MAZE_SIM_IMPLEMENTATION
+#include "maze_sim.h"                   // Required for: MazeSim, UpdateMazeSim()
+#include "maze_random.h"                // Required for: MazeRandom, GetMazeRandomValue()
+#include <stdio.h>                      // Required for: printf(), sscanf()
+#include <stdlib.h>                     // Required for: atoi(), malloc(), realloc(), free()
+#include <string.h>                     // Required for: strcmp()
+#include <math.h>                       // Required for: atan2f(), sqrtf()
+
+#define AUTOPLAY_MAX_ITEMS      16      // Same as game MAZE_ITEMS
+#define AUTOPLAY_BOT_STREAM     2       // Random bot stream id, items use their own stream
+
+// Script input line, repeated for a number of steps
+typedef struct ScriptLine
+{
+    int steps;
+    MazeSimInput input;
+} ScriptLine;
+
+// Bot state for a game
+typedef struct AutoplayBot
+{
+    int type;                   // 0-Field, 1-Random, 2-Script
+    DistanceField field;        // Field bot: distance to end cells
+    Point target;               // Field bot 3d: cell walked to
+    MazeRandom random;          // Random bot generator
+    const ScriptLine* script;   // Script bot lines
+    int scriptCount;
+    int scriptLine;             // Script bot current line and step in line
+    int scriptStep;
+} AutoplayBot;
+
+// Load script lines from text file, NULL if file could not be loaded or has no lines
+static ScriptLine* LoadScript(const char* fileName, int* lineCount)
+{
+    FILE* file = fopen(fileName, "rt");
+    ScriptLine* lines = NULL;
+    int capacity = 0;
+    char text[256] = { 0 };
+
+    *lineCount = 0;
+    if (file == NULL) return NULL;
+
+    while (fgets(text, sizeof(text), file) != NULL)
+    {
+        ScriptLine line = { 0 };
+        int count = sscanf(text, "%d %d %d %f %f %f %f", &line.steps, &line.input.move.x, &line.input.move.y,
+            &line.input.walk.x, &line.input.walk.y, &line.input.look.x, &line.input.look.y);
+
+        if ((text[0] == '#') || (count < 3) || (line.steps < 1)) continue;
+
+        if (*lineCount == capacity)
+        {
+            capacity = (capacity == 0)? 64 : 2 * capacity;
+            ScriptLine* newLines = (ScriptLine*)realloc(lines, capacity * sizeof(ScriptLine));
+            if (newLines == NULL) break;
+
+            lines = newLines;
+        }
+
+        lines[(*lineCount)++] = line;
+    }
+
+    fclose(file);
+
+    if (*lineCount == 0)
+    {
+        free(lines);
+        lines = NULL;
+    }
+
+    return lines;
+}
+
+// Get bot input for next simulation step
+static MazeSimInput GetBotInput(AutoplayBot* bot, const MazeSim* sim, float deltaTime)
+{
+    MazeSimInput input = { 0 };
+
+    if (bot->type == 0)
+    {
+        if (sim->mode == 0)
+        {
+            // One cell per step, towards the nearest end cell
+            Point next = GetDistanceFieldNextCell(bot->field, sim->playerCell);
+            input.move = (Point){ next.x - sim->playerCell.x, next.y - sim->playerCell.y };
+        }
+        else
+        {
+            // Walk from cell center to next cell center, turning to face it first
+            float dx = sim->origin.x + bot->target.x - sim->camera.position.x;
+            float dz = sim->origin.z + bot->target.y - sim->camera.position.z;
+            float distance = sqrtf(dx * dx + dz * dz);
+
+            if (distance < 0.01f)
+            {
+                bot->target = GetDistanceFieldNextCell(bot->field, bot->target);
+                dx = sim->origin.x + bot->target.x - sim->camera.position.x;
+                dz = sim->origin.z + bot->target.y - sim->camera.position.z;
+                distance = sqrtf(dx * dx + dz * dz);
+            }
+
+            if (distance >= 0.01f)
+            {
+                float yaw = atan2f(sim->camera.target.z - sim->camera.position.z, sim->camera.target.x - sim->camera.position.x);
+                float turn = (atan2f(dz, dx) - yaw) * RAD2DEG;
+
+                if (turn > 180.0f) turn -= 360.0f;
+                else if (turn < -180.0f) turn += 360.0f;
+
+                float stepDistance = MAZE_SIM_MOVE_SPEED * deltaTime;
+
+                input.look.x = turn;
+                input.walk.x = (distance < stepDistance)? distance / stepDistance : 1.0f;
+            }
+        }
+    }
+    else if (bot->type == 1)
+    {
+        if (sim->mode == 0)
+        {
+            static const Point moves[4] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+            input.move = moves[GetMazeRandomValue(&bot->random, 0, 3)];
+        }
+        else
+        {
+            input.walk.x = 1.0f;
+            input.look.x = (GetMazeRandomFloat(&bot->random) - 0.5f) * 20.0f;
+        }
+    }
+    else
+    {
+        input = bot->script[bot->scriptLine].input;
+
+        if (++bot->scriptStep >= bot->script[bot->scriptLine].steps)
+        {
+            bot->scriptStep = 0;
+            bot->scriptLine = (bot->scriptLine + 1) % bot->scriptCount;
+        }
+    }
+
+    return input;
+}
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int firstSeed = 0;
+    int lastSeed = 9;
+    int width = 64;
+    int height = 64;
+    int mode = 0;                   // 0-2D, 1-3D
+    int botType = 0;                // 0-Field, 1-Random, 2-Script
+    const char* scriptFile = NULL;
+    int stepRate = 60;
+    bool quiet = false;
+    bool validArgs = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (strcmp(argv[i], "-q") == 0) quiet = true;
+        else if (!hasValue) validArgs = false;
+        else if (strcmp(argv[i], "-s") == 0)
+        {
+            int count = sscanf(argv[++i], "%d:%d", &firstSeed, &lastSeed);
+            if (count == 1) lastSeed = firstSeed;
+            else if (count != 2) validArgs = false;
+        }
+        else if (strcmp(argv[i], "-w") == 0) width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-h") == 0) height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0)
+        {
+            i++;
+            if (strcmp(argv[i], "2d") == 0) mode = 0;
+            else if (strcmp(argv[i], "3d") == 0) mode = 1;
+            else validArgs = false;
+        }
+        else if (strcmp(argv[i], "-b") == 0)
+        {
+            i++;
+            if (strcmp(argv[i], "field") == 0) botType = 0;
+            else if (strcmp(argv[i], "random") == 0) botType = 1;
+            else if (strcmp(argv[i], "script") == 0) botType = 2;
+            else validArgs = false;
+        }
+        else if (strcmp(argv[i], "-i") == 0) scriptFile = argv[++i];
+        else if (strcmp(argv[i], "-r") == 0) stepRate = atoi(argv[++i]);
+        else validArgs = false;
+    }
+
+    if (!validArgs || (lastSeed < firstSeed) || (width < 8) || (height < 8) || (width > MAZE_GRID_MAX_SIZE) || (height > MAZE_GRID_MAX_SIZE) ||
+        (stepRate < 1) || ((botType == 2) && (scriptFile == NULL)))
+    {
+        printf("Usage: maze_autoplay [-s first[:last]] [-w width] [-h height] [-m 2d|3d] [-b field|random|script]\n");
+        printf("                     [-i scriptFile] [-r stepRate] [-q]\n\n");
+        printf("    -s  Seeds range, both included, one game per seed (default 0:9)\n");
+        printf("    -w  Maze width, 8 to %d (default 64)\n", MAZE_GRID_MAX_SIZE);
+        printf("    -h  Maze height, 8 to %d (default 64)\n", MAZE_GRID_MAX_SIZE);
+        printf("    -m  Player movement mode: 2d or 3d (default 2d)\n");
+        printf("    -b  Bot: field, random or script (default field)\n");
+        printf("    -i  Script file, required by script bot\n");
+        printf("    -r  Simulation steps per game second (default 60)\n");
+        printf("    -q  Quiet, only print totals\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    AutoplayBot bot = { 0 };
+    ScriptLine* script = NULL;
+    bot.type = botType;
+
+    if (botType == 2)
+    {
+        script = LoadScript(scriptFile, &bot.scriptCount);
+        bot.script = script;
+
+        if (script == NULL)
+        {
+            printf("Script could not be loaded or has no input lines: %s\n", scriptFile);
+            return 1;
+        }
+    }
+
+    float deltaTime = 1.0f / stepRate;
+    int gameCount = lastSeed - firstSeed + 1;
+    int winCount = 0;
+    int failedCount = 0;
+    long long totalSteps = 0;
+    double timeSim = 0.0;
+
+    printf("Mazes %dx%d, seeds %d to %d, %s mode, %s bot, %d steps per second\n\n", width, height, firstSeed, lastSeed,
+        (mode == 0)? "2D" : "3D", (botType == 0)? "field" : (botType == 1)? "random" : "script", stepRate);
+
+    if (!quiet)
+    {
+        printf("     seed | result  |   steps | game s | score\n");
+        printf("----------+---------+---------+--------+------\n");
+    }
+
+    for (int seed = firstSeed; seed <= lastSeed; seed++)
+    {
+        MazeGrid maze = GenMazeGridTiled(width, height, 4, 4, 0.3f, (uint64_t)(unsigned int)seed, 0);
+
+        if (maze.words == NULL)
+        {
+            printf("%9d | maze could not be generated\n", seed);
+            failedCount++;
+            continue;
+        }
+
+        MazeSim sim = InitMazeSim(maze, (MazeGrid){ 0 }, (Vector3){ 0.0f, 0.0f, 0.0f }, (uint64_t)(unsigned int)seed, AUTOPLAY_MAX_ITEMS);
+        sim.mode = mode;
+
+        // Bot state restarted for every game
+        if (botType == 0) UpdateDistanceField(&bot.field, maze, sim.endCells, 4);
+        bot.target = sim.playerCell;
+        bot.random = InitMazeRandomStream((uint64_t)(unsigned int)seed, AUTOPLAY_BOT_STREAM);
+        bot.scriptLine = 0;
+        bot.scriptStep = 0;
+
+        // Play until game restarts (end cell reached or time limit)
+        int events = 0;
+        int score = 0;
+        double time = GetMazeThreadTime();     // Simulation time only, maze generation not included
+
+        while ((events & (MAZE_SIM_EVENT_WIN | MAZE_SIM_EVENT_TIMEOUT)) == 0)
+        {
+            score = sim.score;
+            events = UpdateMazeSim(&sim, GetBotInput(&bot, &sim, deltaTime), deltaTime);
+        }
+
+        time = GetMazeThreadTime() - time;
+        timeSim += time;
+        totalSteps += sim.stepCount;
+
+        bool win = ((events & MAZE_SIM_EVENT_WIN) != 0);
+        if (win) winCount++;
+
+        if (!quiet) printf("%9d | %-7s | %7lld | %6.1f | %5d\n", seed, win? "win" : "timeout", sim.stepCount, sim.stepCount * deltaTime, score);
+
+        UnloadMazeSim(sim);
+        UnloadMazeGrid(maze);
+    }
+
+    UnloadDistanceField(bot.field);
+    free(script);
+
+    int playedCount = gameCount - failedCount;
+
+    printf("\nGames: %d, wins: %d (%.1f%%), failed: %d\n", playedCount, winCount, (playedCount > 0)? 100.0 * winCount / playedCount : 0.0, failedCount);
+    printf("Simulation: %lld steps in %.3f s, %.0f steps/s, %.0fx real time\n", totalSteps, timeSim,
+        (timeSim > 0.0)? totalSteps / timeSim : 0.0, (timeSim > 0.0)? totalSteps * deltaTime / timeSim : 0.0);
+
+    return (failedCount > 0)? 1 : 0;
+}
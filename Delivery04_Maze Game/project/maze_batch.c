@@ -0,0 +1,191 @@
+/*******************************************************************************************
+*
+*   raylib maze batch generator
+*
+*   Generates mazes in bulk for a range of seeds, no window or graphics context required:
+*   mazes are saved as PNG images or maze grid files (.maze), to pre-bake level packs
+*
+*   Reports generation time, wall density and solvability (end cell reachable from start
+*   cell, same connected regions check as the game) for every maze, and mazes generated
+*   per second, to catch generator regressions
+*
+*   Build (raylib installed):
+*       gcc -O2 maze_batch.c -o maze_batch -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   Usage:
+*       maze_batch [-s first[:last]] [-w width] [-h height] [-r spacingRows] [-c spacingCols]
+*                  [-k skipChance] [-t threads] [-f none|png|maze] [-o outputDir] [-q]
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#define MAZE_GRID_IMPLEMENTATION
+#include "maze_grid.h"                  // Required for: MazeGrid, ExportMazeGrid()
+#define MAZE_THREAD_IMPLEMENTATION
+#include "maze_thread.h"                // Required for: MazeThread, used by tiled maze generator, GetMazeThreadTime()
+#define MAZE_GEN_IMPLEMENTATION
+#include "maze_gen.h"                   // Required for: GenMazeGridTiled()
+#define MAZE_REGIONS_IMPLEMENTATION
+#include "maze_regions.h"               // Required for: MazeRegions, UpdateMazeRegions(), CheckMazeCellsConnected()
+#include <stdio.h>                      // Required for: printf(), sscanf()
+#include <stdlib.h>                     // Required for: atoi(), atof()
+#include <string.h>                     // Required for: strcmp()
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int firstSeed = 0;
+    int lastSeed = 9;
+    int width = 64;
+    int height = 64;
+    int spacingRows = 4;
+    int spacingCols = 4;
+    float skipChance = 0.3f;
+    int threadCount = 0;            // 0-All CPU cores
+    const char* format = "none";
+    const char* outputDir = ".";
+    bool quiet = false;
+    bool validArgs = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (strcmp(argv[i], "-q") == 0) quiet = true;
+        else if (!hasValue) validArgs = false;
+        else if (strcmp(argv[i], "-s") == 0)
+        {
+            int count = sscanf(argv[++i], "%d:%d", &firstSeed, &lastSeed);
+            if (count == 1) lastSeed = firstSeed;
+            else if (count != 2) validArgs = false;
+        }
+        else if (strcmp(argv[i], "-w") == 0) width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-h") == 0) height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0) spacingRows = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0) spacingCols = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-k") == 0) skipChance = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0) threadCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0) format = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0) outputDir = argv[++i];
+        else validArgs = false;
+    }
+
+    if ((strcmp(format, "none") != 0) && (strcmp(format, "png") != 0) && (strcmp(format, "maze") != 0)) validArgs = false;
+
+    if (!validArgs || (lastSeed < firstSeed) || (width < 8) || (height < 8) || (width > MAZE_GRID_MAX_SIZE) || (height > MAZE_GRID_MAX_SIZE) ||
+        (spacingRows < 1) || (spacingCols < 1) || (skipChance < 0.0f) || (skipChance > 1.0f) || (threadCount < 0))
+    {
+        printf("Usage: maze_batch [-s first[:last]] [-w width] [-h height] [-r spacingRows] [-c spacingCols]\n");
+        printf("                  [-k skipChance] [-t threads] [-f none|png|maze] [-o outputDir] [-q]\n\n");
+        printf("    -s  Seeds range, both included (default 0:9)\n");
+        printf("    -w  Maze width, 8 to %d (default 64)\n", MAZE_GRID_MAX_SIZE);
+        printf("    -h  Maze height, 8 to %d (default 64)\n", MAZE_GRID_MAX_SIZE);
+        printf("    -r  Spacing rows (default 4)\n");
+        printf("    -c  Spacing columns (default 4)\n");
+        printf("    -k  Points skip chance, 0.0 to 1.0 (default 0.3)\n");
+        printf("    -t  Generator threads, 0 for all CPU cores (default 0)\n");
+        printf("    -f  Output format: none, png or maze (default none)\n");
+        printf("    -o  Output directory, must exist (default .)\n");
+        printf("    -q  Quiet, only print totals\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Solvability is checked between game start and end cells, regions data reused for every maze
+    Point start = { 1, 1 };
+    Point end = { width - 2, height - 2 };
+    MazeRegions regions = { 0 };
+
+    int mazeCount = lastSeed - firstSeed + 1;
+    int solvableCount = 0;
+    int failedCount = 0;            // Mazes not generated
+    int unsavedCount = 0;           // Mazes generated but not saved
+    int uncheckedCount = 0;         // Mazes generated but solvability not checked (regions data not allocated)
+    double timeGen = 0.0;
+    double timeTotal = GetMazeThreadTime();
+    double wallDensity = 0.0;
+
+    printf("Mazes %dx%d, spacing %dx%d, skip chance %.2f, seeds %d to %d, %d threads\n\n", width, height, spacingRows, spacingCols, skipChance,
+        firstSeed, lastSeed, (threadCount > 0)? threadCount : GetMazeThreadCpuCount());
+
+    if (!quiet)
+    {
+        printf("     seed |  gen ms | walls | solvable\n");
+        printf("----------+---------+-------+---------\n");
+    }
+
+    for (int seed = firstSeed; seed <= lastSeed; seed++)
+    {
+        // Generation time on all threads (wall clock), save and check not included
+        double time = GetMazeThreadTime();
+        MazeGrid maze = GenMazeGridTiled(width, height, spacingRows, spacingCols, skipChance, (uint64_t)(unsigned int)seed, threadCount);
+        time = GetMazeThreadTime() - time;
+
+        if (maze.words == NULL)
+        {
+            printf("%9d | maze could not be generated\n", seed);
+            failedCount++;
+            continue;
+        }
+
+        timeGen += time;
+
+        // Wall density, counting set bits of every row word (padding bits excluded)
+        long long walls = 0;
+        for (int y = 0; y < maze.height; y++)
+        {
+            for (int i = 0; i < maze.rowWords; i++)
+            {
+                uint64_t word = maze.words[(size_t)y * maze.rowWords + i];
+                if ((i == maze.rowWords - 1) && (maze.width % 64 != 0)) word &= ~(~0ULL << (maze.width % 64));
+
+                while (word != 0)
+                {
+                    word &= word - 1;
+                    walls++;
+                }
+            }
+        }
+
+        double density = (double)walls / ((double)maze.width * maze.height);
+        bool checked = UpdateMazeRegions(&regions, maze);
+        bool solvable = checked && CheckMazeCellsConnected(regions, start, end);
+
+        wallDensity += density;
+        if (solvable) solvableCount++;
+        if (!checked) uncheckedCount++;
+
+        bool saved = true;
+        if (strcmp(format, "png") == 0)
+        {
+            Image image = LoadImageFromMazeGrid(maze);
+            saved = ExportImage(image, TextFormat("%s/maze_%d.png", outputDir, seed));
+            UnloadImage(image);
+        }
+        else if (strcmp(format, "maze") == 0) saved = ExportMazeGrid(maze, TextFormat("%s/maze_%d.maze", outputDir, seed));
+
+        if (!saved) unsavedCount++;
+
+        if (!quiet) printf("%9d | %7.2f | %4.1f%% | %s%s\n", seed, time * 1000.0, density * 100.0, checked? (solvable? "yes" : "no") : "not checked", saved? "" : " (not saved)");
+
+        UnloadMazeGrid(maze);
+    }
+
+    timeTotal = GetMazeThreadTime() - timeTotal;
+
+    UnloadMazeRegions(regions);
+
+    int generatedCount = mazeCount - failedCount;
+    if (generatedCount < 1) generatedCount = 1;
+
+    printf("\nMazes: %d, solvable: %d (%.1f%%), failed: %d, not checked: %d, not saved: %d\n", mazeCount, solvableCount, 100.0 * solvableCount / mazeCount,
+        failedCount, uncheckedCount, unsavedCount);
+    printf("Average wall density: %.1f%%\n", 100.0 * wallDensity / generatedCount);
+    printf("Generation: %.3f s, %.2f ms/maze, %.1f mazes/s\n", timeGen, timeGen * 1000.0 / generatedCount, (timeGen > 0.0)? generatedCount / timeGen : 0.0);
+    printf("Total (with checks and output): %.3f s, %.1f mazes/s\n", timeTotal, (timeTotal > 0.0)? mazeCount / timeTotal : 0.0);
+
+    return ((failedCount > 0) || (uncheckedCount > 0) || (unsavedCount > 0))? 1 : 0;
+}
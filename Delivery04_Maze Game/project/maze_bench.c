@@ -0,0 +1,610 @@
+/*******************************************************************************************
+*
+*   raylib maze micro-benchmarks
+*
+*   Measures the hot paths of the game on generated mazes, no window required:
+*       gen         - Serial maze generation, GenMazeGrid()
+*       gen_tiled   - Tiled maze generation on all CPU cores, GenMazeGridTiled()
+*       path_astar  - A* path between two random walkable cells, LoadPathAStar()
+*       items       - Collectible items placement, SetCollectibleItems()
+*       items_100k  - Collectible items placement, 100000 items at least 2 cells apart
+*       collision   - 3d player circle vs maze walls check, CheckCollisionMazeCircle()
+*       collision_move - 3d player swept movement sliding along walls, MoveMazeCircle()
+*       regions     - Walkable cells connected regions labelling, UpdateMazeRegions()
+*       regions_edit - Regions update on one map edit, a walkable cell painted wall and walkable again, UpdateMazeRegionsCell()
+*       mesh_chunk  - 3d model chunk mesh generation (one map edit), GenMeshMazeChunk()
+*       visibility  - 3d view potentially visible cells, rays across maze grid, UpdateMazeVisibility()
+*
+*   Every benchmark runs for every maze size, spacing and skip chance combination,
+*   with fixed seeds: same inputs on every run, results comparable between commits.
+*
+*   Reports time per operation, heap allocations and bytes allocated per operation,
+*   peak heap bytes used while running and peak process resident memory (RSS) so far,
+*   results are also written as JSON to track them over time.
+*
+*   Build (raylib installed):
+*       gcc -O2 maze_bench.c -o maze_bench -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   Usage:
+*       maze_bench [-s sizes] [-r spacings] [-k skipChances] [-b benchmarks] [-t minTime]
+*                  [-l label] [-o output.json]
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#define MAZE_THREAD_IMPLEMENTATION
+#include "maze_thread.h"                // Required for: MazeThread, GetMazeThreadCpuCount(), GetMazeThreadTime()
+#include "maze_random.h"                // Required for: MazeRandom, GetMazeRandomValue()
+#include <stdio.h>                      // Required for: printf(), fprintf(), fopen(), fclose()
+#include <stdlib.h>                     // Required for: malloc(), calloc(), realloc(), free(), strtol(), strtod()
+#include <string.h>                     // Required for: strcmp(), strstr(), strlen(), memset()
+#include <time.h>                       // Required for: time()
+#include <math.h>                       // Required for: cosf(), sinf()
+
+#if defined(_WIN32)
+    // Win32 functions declared here, windows.h conflicts with raylib
+    typedef struct BenchProcessMemory {
+        unsigned long cb;
+        unsigned long PageFaultCount;
+        size_t PeakWorkingSetSize;
+        size_t WorkingSetSize;
+        size_t QuotaPeakPagedPoolUsage;
+        size_t QuotaPagedPoolUsage;
+        size_t QuotaPeakNonPagedPoolUsage;
+        size_t QuotaNonPagedPoolUsage;
+        size_t PagefileUsage;
+        size_t PeakPagefileUsage;
+    } BenchProcessMemory;       // PROCESS_MEMORY_COUNTERS
+
+    __declspec(dllimport) void* __stdcall GetCurrentProcess(void);
+    __declspec(dllimport) int __stdcall K32GetProcessMemoryInfo(void* process, BenchProcessMemory* counters, unsigned long size);
+#else
+    #include <sys/resource.h>           // Required for: getrusage()
+#endif
+
+#define BENCH_SEED              67218   // Base seed for mazes and queries
+#define BENCH_MAX_VALUES        16      // Max values per command line list
+#define BENCH_MAX_ITERATIONS    100000000
+#define BENCH_QUERY_COUNT       16      // Path queries per maze, used round-robin
+#define BENCH_POSITION_COUNT    4096    // Collision positions per maze, used round-robin
+#define BENCH_ITEM_COUNT        16      // Same as game MAZE_ITEMS
+#define BENCH_MANY_ITEM_COUNT   100000  // Items for many items placement, limited by maze free cells
+#define BENCH_MANY_ITEM_SPACING 2       // Items min distance for many items placement, in cells
+#define BENCH_PLAYER_RADIUS     0.1f    // Same as game player radius
+#define BENCH_PLAYER_MOVE       0.09f   // Player movement per step, same as game at 60 steps per second
+#define BENCH_VIEW_FOV          1.44f   // Same as game 3d view horizontal field of view at 1280x720 (with margin), in radians
+#define BENCH_VIEW_RAYS         640     // Same as game 3d view rays at 1280x720, one ray every 2 pixels
+
+//----------------------------------------------------------------------------------
+// Heap allocations tracking
+//----------------------------------------------------------------------------------
+// NOTE: Maze modules included after these macros call the tracking functions, only their
+// allocations are counted (not raylib ones). Modules allocate on the calling thread only
+// (tiled generator workers do not allocate), so counters are not synchronized
+#define BENCH_HEAP_HEADER       16      // Block size stored before every block, keeps malloc alignment
+
+typedef struct BenchHeap
+{
+    long long allocCount;       // Allocations (malloc, calloc, growing realloc)
+    long long allocBytes;       // Bytes requested by allocations
+    size_t liveBytes;           // Bytes currently allocated
+    size_t peakBytes;           // Max bytes allocated at the same time
+} BenchHeap;
+
+static BenchHeap benchHeap = { 0 };
+
+static void* BenchHeapTrack(unsigned char* block, size_t size)
+{
+    if (block == NULL) return NULL;
+
+    *(size_t*)block = size;
+    benchHeap.allocCount++;
+    benchHeap.allocBytes += (long long)size;
+    benchHeap.liveBytes += size;
+    if (benchHeap.liveBytes > benchHeap.peakBytes) benchHeap.peakBytes = benchHeap.liveBytes;
+
+    return block + BENCH_HEAP_HEADER;
+}
+
+static void* BenchMalloc(size_t size)
+{
+    return BenchHeapTrack((unsigned char*)malloc(size + BENCH_HEAP_HEADER), size);
+}
+
+static void* BenchCalloc(size_t count, size_t size)
+{
+    if ((size != 0) && (count > ((size_t)-1 - BENCH_HEAP_HEADER) / size)) return NULL;
+
+    return BenchHeapTrack((unsigned char*)calloc(1, count * size + BENCH_HEAP_HEADER), count * size);
+}
+
+static void BenchFree(void* ptr)
+{
+    if (ptr == NULL) return;
+
+    unsigned char* block = (unsigned char*)ptr - BENCH_HEAP_HEADER;
+    benchHeap.liveBytes -= *(size_t*)block;
+    free(block);
+}
+
+static void* BenchRealloc(void* ptr, size_t size)
+{
+    if (ptr == NULL) return BenchMalloc(size);
+
+    unsigned char* block = (unsigned char*)ptr - BENCH_HEAP_HEADER;
+    size_t oldSize = *(size_t*)block;
+
+    block = (unsigned char*)realloc(block, size + BENCH_HEAP_HEADER);
+    if (block == NULL) return NULL;
+
+    // Only growing reallocations count as allocations
+    *(size_t*)block = size;
+    benchHeap.liveBytes += size - oldSize;
+    if (size > oldSize)
+    {
+        benchHeap.allocCount++;
+        benchHeap.allocBytes += (long long)(size - oldSize);
+    }
+    if (benchHeap.liveBytes > benchHeap.peakBytes) benchHeap.peakBytes = benchHeap.liveBytes;
+
+    return block + BENCH_HEAP_HEADER;
+}
+
+#define malloc(size) BenchMalloc(size)
+#define calloc(count, size) BenchCalloc(count, size)
+#define realloc(ptr, size) BenchRealloc(ptr, size)
+#define free(ptr) BenchFree(ptr)
+
+#define MAZE_GRID_IMPLEMENTATION
+#include "maze_grid.h"                  // Required for: MazeGrid, IsCellWalkable()
+#define MAZE_PATH_IMPLEMENTATION
+#include "maze_path.h"                  // Required for: LoadPathAStar(), UnloadPathAStarData()
+#define MAZE_GEN_IMPLEMENTATION
+#include "maze_gen.h"                   // Required for: GenMazeGrid(), GenMazeGridTiled(), GetMazeRandomWalkableCell()
+#define MAZE_ITEMS_IMPLEMENTATION
+#include "maze_items.h"                 // Required for: ItemStore, SetCollectibleItems()
+#define MAZE_COLLISION_IMPLEMENTATION
+#include "maze_collision.h"             // Required for: CheckCollisionMazeCircle(), MoveMazeCircle()
+#define MAZE_REGIONS_IMPLEMENTATION
+#include "maze_regions.h"               // Required for: MazeRegions, UpdateMazeRegions()
+#define MAZE_MESH_IMPLEMENTATION
+#include "maze_mesh.h"                  // Required for: GenMeshMazeChunk()
+#define MAZE_VISIBILITY_IMPLEMENTATION
+#include "maze_visibility.h"            // Required for: MazeVisibility, UpdateMazeVisibility()
+
+//----------------------------------------------------------------------------------
+// Benchmarks
+//----------------------------------------------------------------------------------
+// Benchmark inputs, shared by all benchmarks of a maze configuration
+typedef struct BenchData
+{
+    int size;                   // Maze width and height
+    int spacing;                // Maze spacing rows and columns
+    float skipChance;           // Maze points skip chance
+    MazeGrid maze;              // Maze used by path, items and collision benchmarks
+    Point queries[BENCH_QUERY_COUNT][2];        // Path queries, start and end cells
+    Vector2 positions[BENCH_POSITION_COUNT];    // Collision positions, in world units
+    Vector2 moves[BENCH_POSITION_COUNT];        // Collision movements from positions, in world units
+    Point startCells[4];        // Items excluded cells, same as game
+    Point endCells[4];
+    ItemStore items;            // Items store, loaded once for all configurations (many items capacity)
+    MazeRegions regions;        // Regions data, reloaded when maze size changes, labelled for every maze
+    MazeVisibility visibility;  // Visibility data, loaded for every maze
+    volatile long long sink;    // Operations results, avoids compiler removing them
+} BenchData;
+
+// Benchmark function, runs iterations operations
+typedef void (*BenchFunc)(BenchData* data, long long iterations);
+
+typedef struct Benchmark
+{
+    const char* name;
+    BenchFunc func;
+} Benchmark;
+
+// Benchmark result for a maze configuration
+typedef struct BenchResult
+{
+    long long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+    size_t peakHeapBytes;
+    long long peakRssKB;
+} BenchResult;
+
+static void BenchGen(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        MazeRandom random = InitMazeRandom(BENCH_SEED + i);
+        MazeGrid maze = GenMazeGrid(data->size, data->size, data->spacing, data->spacing, data->skipChance, &random);
+        data->sink += maze.words[maze.rowWords];
+        UnloadMazeGrid(maze);
+    }
+}
+
+static void BenchGenTiled(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        MazeGrid maze = GenMazeGridTiled(data->size, data->size, data->spacing, data->spacing, data->skipChance, BENCH_SEED + i, 0);
+        data->sink += maze.words[maze.rowWords];
+        UnloadMazeGrid(maze);
+    }
+}
+
+static void BenchPathAStar(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        Point* query = data->queries[i % BENCH_QUERY_COUNT];
+        int pointCount = 0;
+        Point* path = LoadPathAStar(data->maze, query[0], query[1], &pointCount);
+        data->sink += pointCount;
+        free(path);
+    }
+}
+
+static void BenchItems(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        MazeRandom random = InitMazeRandom(BENCH_SEED + i);
+        SetCollectibleItems(data->maze, &random, data->startCells, data->endCells, &data->items, BENCH_ITEM_COUNT, 1);
+        data->sink += data->items.count;
+    }
+}
+
+static void BenchItemsMany(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        MazeRandom random = InitMazeRandom(BENCH_SEED + i);
+        data->sink += SetCollectibleItems(data->maze, &random, data->startCells, data->endCells, &data->items, BENCH_MANY_ITEM_COUNT, BENCH_MANY_ITEM_SPACING);
+    }
+}
+
+static void BenchCollision(BenchData* data, long long iterations)
+{
+    Vector2 origin = { 0.0f, 0.0f };
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        data->sink += CheckCollisionMazeCircle(data->maze, origin, data->positions[i % BENCH_POSITION_COUNT], BENCH_PLAYER_RADIUS);
+    }
+}
+
+static void BenchCollisionMove(BenchData* data, long long iterations)
+{
+    Vector2 origin = { 0.0f, 0.0f };
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        Vector2 position = MoveMazeCircle(data->maze, origin, data->positions[i % BENCH_POSITION_COUNT], data->moves[i % BENCH_POSITION_COUNT], BENCH_PLAYER_RADIUS);
+        data->sink += (long long)position.x;
+    }
+}
+
+static void BenchRegions(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        UpdateMazeRegions(&data->regions, data->maze);
+        data->sink += data->regions.regionCount;
+    }
+}
+
+static void BenchRegionsEdit(BenchData* data, long long iterations)
+{
+    for (long long i = 0; i < iterations; i++)
+    {
+        // NOTE: Cell painted back, map and regions are the same after every operation
+        Point cell = data->queries[i % BENCH_QUERY_COUNT][0];
+
+        SetMazeGridCell(&data->maze, cell.x, cell.y, true);
+        data->sink += UpdateMazeRegionsCell(&data->regions, data->maze, cell);
+        SetMazeGridCell(&data->maze, cell.x, cell.y, false);
+        data->sink += UpdateMazeRegionsCell(&data->regions, data->maze, cell);
+    }
+}
+
+static void BenchMeshChunk(BenchData* data, long long iterations)
+{
+    int chunksX = (data->maze.width + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE;
+    int chunksY = (data->maze.height + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE;
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        // NOTE: Mesh is not uploaded (no GPU), only CPU data is freed
+        int chunk = (int)(i % (chunksX * chunksY));
+        Mesh mesh = GenMeshMazeChunk(data->maze, chunk % chunksX, chunk / chunksX);
+        data->sink += mesh.vertexCount;
+        RL_FREE(mesh.vertices);
+        RL_FREE(mesh.normals);
+        RL_FREE(mesh.texcoords);
+        RL_FREE(mesh.texcoords2);
+        RL_FREE(mesh.indices);
+    }
+}
+
+static void BenchVisibility(BenchData* data, long long iterations)
+{
+    Vector2 origin = { 0.0f, 0.0f };
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        // NOTE: Movements used as view directions
+        UpdateMazeVisibility(&data->visibility, data->maze, origin, data->positions[i % BENCH_POSITION_COUNT], data->moves[i % BENCH_POSITION_COUNT], BENCH_VIEW_FOV, BENCH_VIEW_RAYS);
+        data->sink += data->visibility.chunkCount;
+    }
+}
+
+static const Benchmark benchmarks[] = {
+    { "gen", BenchGen },
+    { "gen_tiled", BenchGenTiled },
+    { "path_astar", BenchPathAStar },
+    { "items", BenchItems },
+    { "items_100k", BenchItemsMany },
+    { "collision", BenchCollision },
+    { "collision_move", BenchCollisionMove },
+    { "regions", BenchRegions },
+    { "regions_edit", BenchRegionsEdit },
+    { "mesh_chunk", BenchMeshChunk },
+    { "visibility", BenchVisibility },
+};
+
+//----------------------------------------------------------------------------------
+// Module internal functions
+//----------------------------------------------------------------------------------
+// Get peak resident memory of the process, in KB (0 if not available)
+static long long GetBenchPeakRss(void)
+{
+#if defined(_WIN32)
+    BenchProcessMemory counters = { 0 };
+    counters.cb = sizeof(BenchProcessMemory);
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(BenchProcessMemory))) return (long long)(counters.PeakWorkingSetSize / 1024);
+
+    return 0;
+#else
+    struct rusage usage = { 0 };
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #if defined(__APPLE__)
+    return (long long)usage.ru_maxrss / 1024;     // Bytes on macOS
+    #else
+    return (long long)usage.ru_maxrss;            // KB on Linux and BSD
+    #endif
+#endif
+}
+
+// Run benchmark, increasing iterations until run time reaches min time
+// NOTE: Every run repeats the same operations from the first one, so runs are comparable
+static BenchResult RunBenchmark(Benchmark benchmark, BenchData* data, double minTime)
+{
+    BenchResult result = { 0 };
+    long long iterations = 1;
+
+    // Warm-up operation, first run allocates persistent workspaces (A* search data)
+    benchmark.func(data, 1);
+
+    while (true)
+    {
+        benchHeap.allocCount = 0;
+        benchHeap.allocBytes = 0;
+        benchHeap.peakBytes = benchHeap.liveBytes;
+
+        // NOTE: Wall clock time, generation benchmarks run on worker threads
+        double time = GetMazeThreadTime();
+        benchmark.func(data, iterations);
+        time = GetMazeThreadTime() - time;
+
+        if ((time >= minTime) || (iterations >= BENCH_MAX_ITERATIONS))
+        {
+            result.iterations = iterations;
+            result.nsPerOp = time * 1e9 / iterations;
+            result.allocsPerOp = (double)benchHeap.allocCount / iterations;
+            result.bytesPerOp = (double)benchHeap.allocBytes / iterations;
+            result.peakHeapBytes = benchHeap.peakBytes;
+            result.peakRssKB = GetBenchPeakRss();
+            break;
+        }
+
+        // Predict iterations required for min time, with some margin and growth limits
+        double next = (time > 0.0)? 1.2 * iterations * minTime / time : 100.0 * iterations;
+        if (next > 100.0 * iterations) next = 100.0 * iterations;
+        if (next < 2.0 * iterations) next = 2.0 * iterations;
+        if (next > BENCH_MAX_ITERATIONS) next = BENCH_MAX_ITERATIONS;
+
+        iterations = (long long)next;
+    }
+
+    return result;
+}
+
+// Parse comma separated values list, returns values count (0 on invalid list)
+static int ParseBenchValues(const char* text, double* values, int maxCount)
+{
+    int count = 0;
+
+    while (*text != '\0')
+    {
+        char* end = NULL;
+        double value = strtod(text, &end);
+
+        if ((end == text) || (count == maxCount)) return 0;
+
+        values[count++] = value;
+        text = end;
+
+        if (*text == ',') text++;
+        else if (*text != '\0') return 0;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    double sizes[BENCH_MAX_VALUES] = { 64, 256, 1024, 4096, 8192 };
+    double spacings[BENCH_MAX_VALUES] = { 2, 4, 8 };
+    double skipChances[BENCH_MAX_VALUES] = { 0.0, 0.3, 0.7 };
+    int sizesCount = 5;
+    int spacingsCount = 3;
+    int skipChancesCount = 3;
+    const char* filter = NULL;      // Comma separated benchmark names, NULL for all
+    double minTime = 0.25;
+    const char* label = "";
+    const char* outputFile = "maze_bench.json";
+    bool validArgs = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc) validArgs = false;
+        else if (strcmp(argv[i], "-s") == 0) sizesCount = ParseBenchValues(argv[++i], sizes, BENCH_MAX_VALUES);
+        else if (strcmp(argv[i], "-r") == 0) spacingsCount = ParseBenchValues(argv[++i], spacings, BENCH_MAX_VALUES);
+        else if (strcmp(argv[i], "-k") == 0) skipChancesCount = ParseBenchValues(argv[++i], skipChances, BENCH_MAX_VALUES);
+        else if (strcmp(argv[i], "-b") == 0) filter = argv[++i];
+        else if (strcmp(argv[i], "-t") == 0) minTime = strtod(argv[++i], NULL);
+        else if (strcmp(argv[i], "-l") == 0) label = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0) outputFile = argv[++i];
+        else validArgs = false;
+    }
+
+    if ((sizesCount == 0) || (spacingsCount == 0) || (skipChancesCount == 0) || (minTime <= 0.0)) validArgs = false;
+
+    for (int i = 0; i < sizesCount; i++) if ((sizes[i] < 8) || (sizes[i] > MAZE_GRID_MAX_SIZE)) validArgs = false;
+    for (int i = 0; i < spacingsCount; i++) if ((spacings[i] < 1) || (spacings[i] > MAZE_GRID_MAX_SIZE)) validArgs = false;
+    for (int i = 0; i < skipChancesCount; i++) if ((skipChances[i] < 0.0) || (skipChances[i] > 1.0)) validArgs = false;
+
+    if (!validArgs)
+    {
+        printf("Usage: maze_bench [-s sizes] [-r spacings] [-k skipChances] [-b benchmarks] [-t minTime]\n");
+        printf("                  [-l label] [-o output.json]\n\n");
+        printf("    -s  Maze sizes list, 8 to %d (default 64,256,1024,4096,8192)\n", MAZE_GRID_MAX_SIZE);
+        printf("    -r  Maze spacings list, rows and columns (default 2,4,8)\n");
+        printf("    -k  Points skip chances list, 0.0 to 1.0 (default 0.0,0.3,0.7)\n");
+        printf("    -b  Benchmarks list: gen,gen_tiled,path_astar,items,items_100k,collision,collision_move,regions,regions_edit,mesh_chunk,visibility (default all)\n");
+        printf("    -t  Min time per benchmark run, in seconds (default 0.25)\n");
+        printf("    -l  Label stored in JSON output, i.e. commit id (default none)\n");
+        printf("    -o  JSON output file (default maze_bench.json)\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    FILE* output = fopen(outputFile, "wt");
+    if (output == NULL)
+    {
+        printf("JSON output file could not be created: %s\n", outputFile);
+        return 1;
+    }
+
+    fprintf(output, "{\n  \"label\": \"%s\",\n  \"timestamp\": %lld,\n  \"seed\": %d,\n  \"cpu_count\": %d,\n  \"min_time\": %g,\n  \"results\": [",
+        label, (long long)time(NULL), BENCH_SEED, GetMazeThreadCpuCount(), minTime);
+
+    printf("Seed %d, %d CPU cores, min time %.2f s\n\n", BENCH_SEED, GetMazeThreadCpuCount(), minTime);
+    printf("benchmark      |  size | spc | skip |  iterations |        ns/op | allocs/op |     bytes/op | peak heap KB | peak RSS KB\n");
+    printf("---------------+-------+-----+------+-------------+--------------+-----------+--------------+--------------+------------\n");
+
+    BenchData* data = (BenchData*)calloc(1, sizeof(BenchData));
+    data->items = LoadItemStore(BENCH_MANY_ITEM_COUNT);
+    int resultCount = 0;
+    int failedCount = 0;
+
+    for (int s = 0; s < sizesCount; s++)
+    {
+        for (int r = 0; r < spacingsCount; r++)
+        {
+            for (int k = 0; k < skipChancesCount; k++)
+            {
+                data->size = (int)sizes[s];
+                data->spacing = (int)spacings[r];
+                data->skipChance = (float)skipChances[k];
+                data->maze = GenMazeGridTiled(data->size, data->size, data->spacing, data->spacing, data->skipChance, BENCH_SEED, 0);
+
+                if (data->maze.words == NULL)
+                {
+                    printf("Maze %dx%d could not be generated\n", data->size, data->size);
+                    failedCount++;
+                    continue;
+                }
+
+                // Path queries and collision positions, same for every run
+                MazeRandom random = InitMazeRandomStream(BENCH_SEED, 1);
+                for (int i = 0; i < BENCH_QUERY_COUNT; i++)
+                {
+                    data->queries[i][0] = GetMazeRandomWalkableCell(data->maze, &random);
+                    data->queries[i][1] = GetMazeRandomWalkableCell(data->maze, &random);
+                }
+
+                for (int i = 0; i < BENCH_POSITION_COUNT; i++)
+                {
+                    Point cell = GetMazeRandomWalkableCell(data->maze, &random);
+                    data->positions[i] = (Vector2){ cell.x + GetMazeRandomFloat(&random) - 0.5f, cell.y + GetMazeRandomFloat(&random) - 0.5f };
+
+                    float angle = GetMazeRandomFloat(&random) * 2.0f * PI;
+                    data->moves[i] = (Vector2){ cosf(angle) * BENCH_PLAYER_MOVE, sinf(angle) * BENCH_PLAYER_MOVE };
+                }
+
+                Point startCells[4] = { { 1, 1 }, { 1, 2 }, { 2, 1 }, { 2, 2 } };
+                Point endCells[4] = {
+                    { data->size - 3, data->size - 3 }, { data->size - 3, data->size - 2 },
+                    { data->size - 2, data->size - 3 }, { data->size - 2, data->size - 2 }
+                };
+                memcpy(data->startCells, startCells, sizeof(startCells));
+                memcpy(data->endCells, endCells, sizeof(endCells));
+
+                data->visibility = LoadMazeVisibility(data->maze.width, data->maze.height, MAZE_MESH_CHUNK_SIZE);
+                UpdateMazeRegions(&data->regions, data->maze);
+
+                for (int b = 0; b < (int)(sizeof(benchmarks) / sizeof(Benchmark)); b++)
+                {
+                    if (filter != NULL)
+                    {
+                        // Match whole names only in the comma separated list
+                        const char* match = strstr(filter, benchmarks[b].name);
+                        size_t length = strlen(benchmarks[b].name);
+
+                        while ((match != NULL) && (((match != filter) && (match[-1] != ',')) || ((match[length] != '\0') && (match[length] != ','))))
+                        {
+                            match = strstr(match + 1, benchmarks[b].name);
+                        }
+
+                        if (match == NULL) continue;
+                    }
+
+                    BenchResult result = RunBenchmark(benchmarks[b], data, minTime);
+
+                    printf("%-14s | %5d | %3d | %.2f | %11lld | %12.1f | %9.2f | %12.1f | %12.1f | %11lld\n", benchmarks[b].name,
+                        data->size, data->spacing, data->skipChance, result.iterations, result.nsPerOp, result.allocsPerOp,
+                        result.bytesPerOp, result.peakHeapBytes / 1024.0, result.peakRssKB);
+
+                    fprintf(output, "%s\n    { \"name\": \"%s\", \"size\": %d, \"spacing\": %d, \"skip_chance\": %.2f, \"iterations\": %lld, "
+                        "\"ns_per_op\": %.1f, \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f, \"peak_heap_bytes\": %llu, \"peak_rss_kb\": %lld }",
+                        (resultCount > 0)? "," : "", benchmarks[b].name, data->size, data->spacing, data->skipChance, result.iterations,
+                        result.nsPerOp, result.allocsPerOp, result.bytesPerOp, (unsigned long long)result.peakHeapBytes, result.peakRssKB);
+                    fflush(output);
+
+                    resultCount++;
+                }
+
+                UnloadMazeGrid(data->maze);
+                UnloadMazeVisibility(data->visibility);
+                UnloadPathAStarData();      // Search workspace is sized for current maze
+            }
+        }
+    }
+
+    fprintf(output, "\n  ]\n}\n");
+    fclose(output);
+    UnloadItemStore(data->items);
+    UnloadMazeRegions(data->regions);
+    free(data);
+
+    printf("\nResults: %d, written to %s\n", resultCount, outputFile);
+
+    return (failedCount > 0)? 1 : 0;
+}
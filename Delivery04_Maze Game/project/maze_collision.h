@@ -0,0 +1,169 @@
+/*******************************************************************************************
+*
+*   maze_collision - Circle collision against maze grid walls
+*
+*   Maze cells are 1x1 world units squares, cell (0, 0) centered on maze origin position:
+*   cell (x, y) covers [origin.x - 0.5f + x, origin.x + 0.5f + x] horizontally,
+*   same vertically. Only the 3x3 cells around the circle cell are checked,
+*   so circle radius must be below 0.5f (player radius in game is 0.1f).
+*
+*   Circle movement is swept in steps no longer than the radius, circle center never
+*   crosses a wall between steps (no tunneling at high speed), and resolved sliding
+*   along walls: penetration is pushed out along the wall normal, movement along the
+*   wall is kept. Cost depends on movement length only, not on maze size.
+*
+*   CONFIGURATION:
+*       #define MAZE_COLLISION_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Map cells walkability
+*
+********************************************************************************************/
+
+#ifndef MAZE_COLLISION_H
+#define MAZE_COLLISION_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: MazeGrid, IsMazeGridWall()
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+Point GetMazeCellFromPosition(MazeGrid grid, Vector2 origin, Vector2 position);                 // Get maze cell containing world position, clamped to maze limits
+bool CheckCollisionMazeCircle(MazeGrid grid, Vector2 origin, Vector2 center, float radius);     // Check collision between circle and maze walls around circle cell
+Vector2 MoveMazeCircle(MazeGrid grid, Vector2 origin, Vector2 center, Vector2 movement, float radius);  // Move circle sliding along maze walls, returns new circle center
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_COLLISION_H
+
+/***********************************************************************************
+*
+*   MAZE_COLLISION IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_COLLISION_IMPLEMENTATION) && !defined(MAZE_COLLISION_IMPLEMENTATION_DONE)
+#define MAZE_COLLISION_IMPLEMENTATION_DONE
+
+#include <math.h>                       // Required for: sqrtf(), ceilf(), fminf()
+
+// Get maze cell containing world position, clamped to maze limits
+Point GetMazeCellFromPosition(MazeGrid grid, Vector2 origin, Vector2 position)
+{
+    int cellX = (int)(position.x - origin.x + 0.5f);
+    int cellY = (int)(position.y - origin.y + 0.5f);
+
+    // Out-of-limits check
+    if (cellX < 0) cellX = 0;
+    else if (cellX >= grid.width) cellX = grid.width - 1;
+
+    if (cellY < 0) cellY = 0;
+    else if (cellY >= grid.height) cellY = grid.height - 1;
+
+    return (Point){ cellX, cellY };
+}
+
+// Check collision between circle and maze walls around circle cell
+// NOTE: Out-of-bounds cells are walls on maze grid
+bool CheckCollisionMazeCircle(MazeGrid grid, Vector2 origin, Vector2 center, float radius)
+{
+    Point cell = GetMazeCellFromPosition(grid, origin, center);
+
+    for (int y = cell.y - 1; y <= cell.y + 1; y++)
+    {
+        for (int x = cell.x - 1; x <= cell.x + 1; x++)
+        {
+            if (IsMazeGridWall(grid, x, y) &&
+                CheckCollisionCircleRec(center, radius, (Rectangle){ origin.x - 0.5f + x * 1.0f, origin.y - 0.5f + y * 1.0f, 1.0f, 1.0f })) return true;
+        }
+    }
+
+    return false;
+}
+
+// Push circle out of maze walls around circle cell, returns true if circle was colliding
+// NOTE: Center inside a wall cell is pushed out through the nearest cell side
+static bool ResolveMazeCircleWalls(MazeGrid grid, Vector2 origin, Vector2* center, float radius)
+{
+    Point cell = GetMazeCellFromPosition(grid, origin, *center);
+    bool collision = false;
+
+    for (int y = cell.y - 1; y <= cell.y + 1; y++)
+    {
+        for (int x = cell.x - 1; x <= cell.x + 1; x++)
+        {
+            if (!IsMazeGridWall(grid, x, y)) continue;
+
+            float minX = origin.x - 0.5f + x;
+            float minY = origin.y - 0.5f + y;
+
+            // Wall closest point to circle center
+            Vector2 closest = {
+                (center->x < minX)? minX : (center->x > minX + 1.0f)? minX + 1.0f : center->x,
+                (center->y < minY)? minY : (center->y > minY + 1.0f)? minY + 1.0f : center->y };
+
+            float dx = center->x - closest.x;
+            float dy = center->y - closest.y;
+            float distanceSqr = dx*dx + dy*dy;
+
+            if (distanceSqr >= radius*radius) continue;
+
+            if (distanceSqr > 0.0f)
+            {
+                float distance = sqrtf(distanceSqr);
+                center->x += dx / distance * (radius - distance);
+                center->y += dy / distance * (radius - distance);
+            }
+            else
+            {
+                // Center inside wall cell, nearest side
+                float left = center->x - minX;
+                float right = minX + 1.0f - center->x;
+                float top = center->y - minY;
+                float bottom = minY + 1.0f - center->y;
+                float nearest = fminf(fminf(left, right), fminf(top, bottom));
+
+                if (nearest == left) center->x = minX - radius;
+                else if (nearest == right) center->x = minX + 1.0f + radius;
+                else if (nearest == top) center->y = minY - radius;
+                else center->y = minY + 1.0f + radius;
+            }
+
+            collision = true;
+        }
+    }
+
+    return collision;
+}
+
+// Move circle sliding along maze walls
+// NOTE: Movement split in steps no longer than radius, every step resolved up to 3 times (corners)
+Vector2 MoveMazeCircle(MazeGrid grid, Vector2 origin, Vector2 center, Vector2 movement, float radius)
+{
+    float length = sqrtf(movement.x*movement.x + movement.y*movement.y);
+    int stepCount = (int)ceilf(length / radius);
+    if (stepCount < 1) stepCount = 1;
+
+    Vector2 step = { movement.x / stepCount, movement.y / stepCount };
+
+    for (int i = 0; i < stepCount; i++)
+    {
+        center.x += step.x;
+        center.y += step.y;
+
+        for (int j = 0; j < 3; j++)
+        {
+            if (!ResolveMazeCircleWalls(grid, origin, &center, radius)) break;
+        }
+    }
+
+    return center;
+}
+
+#endif // MAZE_COLLISION_IMPLEMENTATION
@@ -0,0 +1,180 @@
+/*******************************************************************************************
+*
+*   maze_field - Goal distance field (BFS flow field) for maze grids
+*
+*   A multi-source breadth-first search from all goal cells stores, for every walkable
+*   cell, the number of steps to the nearest goal and the neighbour to move to.
+*   Once computed, any cell can query its distance and best next cell in O(1),
+*   so paths to the goal are walked cell by cell without any search.
+*
+*   Field must be recomputed when the map changes (maze regenerated or edited).
+*
+*   CONFIGURATION:
+*       #define MAZE_FIELD_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Point type and map cells walkability
+*
+********************************************************************************************/
+
+#ifndef MAZE_FIELD_H
+#define MAZE_FIELD_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsCellWalkable()
+
+// Goal distance field, per-cell data indexed by cell (y*width + x)
+typedef struct DistanceField
+{
+    int width;                  // Map width in cells
+    int height;                 // Map height in cells
+    int* distance;              // Steps from every cell to the nearest goal, -1 if unreachable
+    unsigned char* direction;   // Neighbour to move to from every cell (0-Left, 1-Up, 2-Down, 3-Right, 4-None)
+    int* queue;                 // Search queue, kept to avoid allocations on every update
+} DistanceField;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+DistanceField LoadDistanceField(int width, int height);             // Load distance field for a map of given size
+void UnloadDistanceField(DistanceField field);                      // Unload distance field data
+void UpdateDistanceField(DistanceField* field, MazeGrid map, const Point* goals, int goalCount);   // Compute distance field from goal cells (multi-source BFS)
+int GetDistanceFieldValue(DistanceField field, Point cell);         // Get steps from cell to the nearest goal, -1 if unreachable
+Point GetDistanceFieldNextCell(DistanceField field, Point cell);    // Get next cell towards the nearest goal, same cell if goal or unreachable
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_FIELD_H
+
+/***********************************************************************************
+*
+*   MAZE_FIELD IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_FIELD_IMPLEMENTATION) && !defined(MAZE_FIELD_IMPLEMENTATION_DONE)
+#define MAZE_FIELD_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), free()
+
+#define FIELD_DIRECTION_NONE    4
+
+// Cell offsets for every direction, last one is no movement
+static const Point fieldOffsets[5] = { { -1, 0 }, { 0, -1 }, { 0, 1 }, { 1, 0 }, { 0, 0 } };
+
+// Load distance field for a map of given size, all cells unreachable
+DistanceField LoadDistanceField(int width, int height)
+{
+    DistanceField field = { 0 };
+    int cellCount = width * height;
+
+    field.width = width;
+    field.height = height;
+    field.distance = (int*)malloc(cellCount * sizeof(int));
+    field.direction = (unsigned char*)malloc(cellCount * sizeof(unsigned char));
+    field.queue = (int*)malloc(cellCount * sizeof(int));
+
+    if ((field.distance == NULL) || (field.direction == NULL) || (field.queue == NULL))
+    {
+        UnloadDistanceField(field);
+        return (DistanceField){ 0 };
+    }
+
+    for (int i = 0; i < cellCount; i++)
+    {
+        field.distance[i] = -1;
+        field.direction[i] = FIELD_DIRECTION_NONE;
+    }
+
+    return field;
+}
+
+// Unload distance field data
+void UnloadDistanceField(DistanceField field)
+{
+    free(field.distance);
+    free(field.direction);
+    free(field.queue);
+}
+
+// Compute distance field from goal cells
+// NOTE: Field is reloaded if map size changed
+void UpdateDistanceField(DistanceField* field, MazeGrid map, const Point* goals, int goalCount)
+{
+    if ((field->width != map.width) || (field->height != map.height))
+    {
+        UnloadDistanceField(*field);
+        *field = LoadDistanceField(map.width, map.height);
+    }
+
+    if (field->distance == NULL) return;
+
+    int cellCount = field->width * field->height;
+    int queueHead = 0;
+    int queueTail = 0;
+
+    for (int i = 0; i < cellCount; i++)
+    {
+        field->distance[i] = -1;
+        field->direction[i] = FIELD_DIRECTION_NONE;
+    }
+
+    // All walkable goal cells are search sources at distance 0
+    for (int i = 0; i < goalCount; i++)
+    {
+        if (!IsCellWalkable(map, goals[i].x, goals[i].y)) continue;
+
+        int cell = goals[i].y * field->width + goals[i].x;
+        if (field->distance[cell] == 0) continue;
+
+        field->distance[cell] = 0;
+        field->queue[queueTail++] = cell;
+    }
+
+    // Breadth-first expansion: every cell is reached first from a neighbour nearest to a goal
+    while (queueHead < queueTail)
+    {
+        int cell = field->queue[queueHead++];
+        int x = cell % field->width;
+        int y = cell / field->width;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = x + fieldOffsets[i].x;
+            int ny = y + fieldOffsets[i].y;
+            if (!IsCellWalkable(map, nx, ny)) continue;
+
+            int neighbour = ny * field->width + nx;
+            if (field->distance[neighbour] >= 0) continue;
+
+            field->distance[neighbour] = field->distance[cell] + 1;
+            field->direction[neighbour] = 3 - i;    // Opposite direction: back towards current cell
+            field->queue[queueTail++] = neighbour;
+        }
+    }
+}
+
+// Get steps from cell to the nearest goal, -1 if unreachable
+int GetDistanceFieldValue(DistanceField field, Point cell)
+{
+    if ((cell.x < 0) || (cell.y < 0) || (cell.x >= field.width) || (cell.y >= field.height) || (field.distance == NULL)) return -1;
+
+    return field.distance[cell.y * field.width + cell.x];
+}
+
+// Get next cell towards the nearest goal, same cell if goal or unreachable
+Point GetDistanceFieldNextCell(DistanceField field, Point cell)
+{
+    if ((cell.x < 0) || (cell.y < 0) || (cell.x >= field.width) || (cell.y >= field.height) || (field.direction == NULL)) return cell;
+
+    Point offset = fieldOffsets[field.direction[cell.y * field.width + cell.x]];
+
+    return (Point){ cell.x + offset.x, cell.y + offset.y };
+}
+
+#endif // MAZE_FIELD_IMPLEMENTATION
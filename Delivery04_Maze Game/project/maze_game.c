@@ -4,6 +4,11 @@
 *
 *   Procedural maze generator using Maze Grid Algorithm
 *
+*   Usage:
+*       maze_game [-w width] [-h height]      Maze size in cells, 8 to 16384 (default 64x64)
+*                 [-fps rate] [-vsync]        Render frame rate, 0 for uncapped (default 60), vsync
+*                 [-items count]              Collectible items placed in maze (default 16)
+*
 *   This game has been created using raylib (www.raylib.com)
 *   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
 *
@@ -14,44 +19,167 @@
 #include "raylib.h"
 #define RAYGUI_IMPLEMENTATION
 #include "raygui.h"                     // Required for immediate-mode UI elements
-#include <stdlib.h>                     // Required for: malloc(), free()
-
-#define MAZE_WIDTH          64
-#define MAZE_HEIGHT         64
+#define MAZE_GRID_IMPLEMENTATION
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsCellWalkable()
+#define MAZE_PATH_IMPLEMENTATION
+#include "maze_path.h"                  // Required for: LoadPathAStar(), PathPlanner, PathGraph
+#define MAZE_FIELD_IMPLEMENTATION
+#include "maze_field.h"                 // Required for: DistanceField
+#define MAZE_REGIONS_IMPLEMENTATION
+#include "maze_regions.h"               // Required for: MazeRegions, UpdateMazeRegions(), RepairMazeRegions()
+#define MAZE_THREAD_IMPLEMENTATION
+#include "maze_thread.h"                // Required for: MazeThread, GetMazeThreadTime(), maze build and path query workers
+#define MAZE_GEN_IMPLEMENTATION
+#include "maze_gen.h"                   // Required for: GenMazeGridTiled()
+#include "maze_random.h"                // Required for: MazeRandom, GetMazeRandomValue()
+#define MAZE_ITEMS_IMPLEMENTATION
+#include "maze_items.h"                 // Required for: CollectibleItem, SetCollectibleItems()
+#define MAZE_COLLISION_IMPLEMENTATION
+#include "maze_collision.h"             // Required for: MoveMazeCircle(), used by game simulation
+#define MAZE_SIM_IMPLEMENTATION
+#include "maze_sim.h"                   // Required for: MazeSim, UpdateMazeSim()
+#define MAZE_LAYER_IMPLEMENTATION
+#include "maze_layer.h"                 // Required for: MazeLayer, cached 2d maze tiles
+#define MAZE_MESH_IMPLEMENTATION
+#include "maze_mesh.h"                  // Required for: MazeModel, chunked 3d maze model
+#define MAZE_VISIBILITY_IMPLEMENTATION
+#include "maze_visibility.h"            // Required for: MazeVisibility, 3d view potentially visible cells
+#define MAZE_PICKUPS_IMPLEMENTATION
+#include "maze_pickups.h"               // Required for: PickupBatch, instanced 3d items
+#include <stdlib.h>                     // Required for: malloc(), free(), atoi()
+#include <string.h>                     // Required for: strcmp(), strcpy(), memcpy()
+#include <math.h>                       // Required for: expf(), floorf(), atan2f(), atanf(), tanf(), cosf(), sqrtf(), fabsf()
+
+#define MAZE_WIDTH          64          // Default maze width, command line: -w <width>
+#define MAZE_HEIGHT         64          // Default maze height, command line: -h <height>
+#define MAZE_MIN_SIZE       8
 #define MAZE_DRAW_SCALE     10.0f
+#define MAZE_CLUSTER_SIZE   16          // Hierarchical pathfinding cluster size, in cells
 
-#define MAX_MAZE_ITEMS      16
-#define TIME_LIMIT_SECONDS 90000
+#define MAZE_FIELD_MAX_CELLS    (2048*2048)     // Max cells for per-cell search data (distance field, D* Lite, A*, JPS), bigger mazes use HPA* only
+#define MAZE_VIEW_FOV_MARGIN    10.0f           // 3d visibility rays extra horizontal field of view, in degrees
 
-// Declare new data type: Point
-typedef struct Point
-{
-    int x;
-    int y;
-} Point;
+#define MAZE_ITEMS          16          // Default collectible items count, command line: -items <count>
 
-typedef struct CollectibleItem
-{
-    Point position;
-    bool collected;
-    int value;
-    Color color;
-} CollectibleItem;
+#define GAME_STEP_RATE              60      // Game simulation steps per second, independent of render frame rate
+#define GAME_MAX_STEPS_PER_FRAME    8       // Max simulation steps per frame, slower frames drop game time
+#define GAME_CAMERA_FOLLOW_SPEED    10.0f   // Camera 2D follow smoothing, higher is faster
+#define GAME_CAMERA_MIN_ZOOM        0.2f    // Camera 2D min zoom, 2d maze layer caches all chunks visible at min zoom
+#define GAME_PATH_FOLLOW_RANGE      8       // Big mazes game path points checked around player point, player out of them searches path again
 
-// Generate procedural maze image, using grid-based algorithm
+// Maze build, new maze data built on a worker thread while the game keeps running with the current maze
+// NOTE: Worker only uses CPU, GPU data (textures, meshes) is loaded on main thread once build is done
+typedef struct MazeBuild
+{
+    // Build configuration, set before starting worker
+    int width;                  // Maze width, default size used if maze can not be generated
+    int height;                 // Maze height
+    int spacingRows;            // Maze generator configuration
+    int spacingCols;
+    float skipChance;
+    int seed;
+    int itemCount;              // Collectible items placed
+    Vector2 screenSize;         // Screen size, maze centered on screen
+
+    // Build results, only read by main thread once worker is joined
+    bool fallback;              // Maze could not be generated with requested size, default size used
+    MazeGrid grid;              // Maze map
+    Image image;                // Maze image, GPU texture data
+    Vector3 origin;             // 3d model and simulation position
+    MazeSim sim;                // Game restarted on new maze
+    MazeRegions regions;        // Connected regions, only for supported sizes
+    MazeGrid itemsGrid;         // Cells reachable from start
+    bool connected;             // End cells reachable from start
+    DistanceField goalField;    // Distance to end cells, only for supported sizes
+    PathPlanner planner;        // Editor path planner, only for supported sizes
+    PathGraph pathGraph;        // Hierarchical search graph, clusters built on first search
+    Mesh* chunkMeshes;          // 3d model chunk meshes CPU data, only if all chunks can be loaded
+
+    volatile int progress;      // Build progress (0 to 100), only written by worker, read by main thread for UI
+    double buildTime;           // Build time, in seconds
+} MazeBuild;
+
+// Startup asset file decoded on a worker thread, GPU or audio device data loaded on main thread
+typedef struct AssetLoad
+{
+    char fileName[64];          // Asset file name
+    int type;                   // Asset type: 0-Image, 1-Wave
+    Image image;                // Decoded image, texture loaded on main thread
+    Wave wave;                  // Decoded sound wave, sound loaded on main thread
+    double loadTime;            // Decode time, in seconds
+} AssetLoad;
+
+// Path query searched on a worker thread, big mazes paths (HPA*) take seconds to search
+// NOTE: Worker searches a copy of the maze grid and uses the path graph until joined,
+// map edits done meanwhile are kept and applied to the path graph by main thread once joined
+typedef struct PathQuery
+{
+    PathGraph* graph;           // Path graph, only used by worker while searching
+    MazeGrid grid;              // Maze grid copy searched by worker, kept between queries
+    Point start;                // Path start cell
+    Point end;                  // Path end cell
+    int target;                 // Path searched for: 0-Editor path, 1-Game path
+    bool searching;             // Worker started, results not read yet
+
+    Point* edits;               // Cells edited while searching
+    int editCount;
+    int editCapacity;
+    bool editsLost;             // Edits could not be stored, path graph must be loaded again
+
+    // Query results, only read by main thread once worker is joined
+    Point* path;                // Path points, from end to start
+    int pointCount;
+    int expandedCount;
+    double searchTime;          // Search time, in seconds
+} PathQuery;
+
+// Get game simulation input from keyboard for one simulation step, for player movement mode
 // NOTE: Functions defined as static are internal to the module
-static Image GenImageMaze(int width, int height, int spacingRows, int spacingCols, float skipChance);
+static MazeSimInput GetMazeSimInput(int mode, float deltaTime);
+
+// Update maze regions after map changes, items grid set to cells reachable from start cell
+// NOTE: Returns true if an end cell (4 cells) can be reached from start cell
+static bool UpdateMazeReachability(MazeRegions* regions, MazeGrid* itemsGrid, MazeGrid mazeGrid, Point startCell, const Point* endCells);
+
+// Update maze regions after a single cell edit, items grid only updated on edited cell when possible
+// NOTE: Returns true if an end cell can be reached from start cell, relabel set if regions could be split
+static bool UpdateMazeReachabilityCell(MazeRegions* regions, MazeGrid* itemsGrid, MazeGrid mazeGrid, Point startCell, const Point* endCells, Point cell, bool* relabel);
+
+// Build new maze data with build configuration, worker thread function (only CPU work)
+static int BuildMaze(void* data);
+
+// Unload maze build results, build not used (i.e. exit while building)
+static void UnloadMazeBuild(MazeBuild build);
+
+// Load asset file data (image or wave), worker thread function (only CPU work)
+static int LoadAssetFile(void* data);
 
-// Set collectible items in the maze
-static void SetCollectibleItems(Image imMaze, Point startCells[], Point endCells[], CollectibleItem collectibleItems[]);
+// Search path query on path graph, worker thread function (only CPU work)
+static int SearchPathQuery(void* data);
 
-// Get shorter path between two points, implements pathfinding algorithm: A*
-static Point* LoadPathAStar(Image map, Point start, Point end, int* pointCount);
+// Start path query on a worker thread, maze grid copied for the worker (searched on calling thread if no thread available)
+// NOTE: Returns worker thread, NULL if query could not be started or was searched on calling thread
+static MazeThread* StartPathQuery(PathQuery* query, PathGraph* graph, MazeGrid mazeGrid, Point start, Point end, int target);
+
+// Notify a map cell edit to path graph, edit kept until path query worker is joined if searching
+static void UpdatePathQueryCell(PathQuery* query, PathGraph* graph, MazeGrid mazeGrid, Point cell);
+
+// Get index of cell in path, only points up to range away from index checked, returns -1 if not found
+static int GetPathPointIndex(const Point* path, int pointCount, Point cell, int index, int range);
+
+// Get maze cells visible by 2d camera, inclusive range clamped to maze size (empty if min > max)
+static void GetMazeViewCells(Camera2D camera, Vector2 position, MazeGrid mazeGrid, Point* min, Point* max);
+
+// Draw collectible items on visible cells, only visible cells searched when fewer than items
+static void DrawCollectibleItems2D(ItemStore items, Vector2 position, Point viewMin, Point viewMax);
+
+// Draw collectible items 3d models on potentially visible cells, only visible cells searched when fewer than items
+static void DrawCollectibleItems3D(ItemStore items, PickupBatch* batch, Vector3 position, MazeVisibility visibility);
 
 //----------------------------------------------------------------------------------
 // Main entry point
 //----------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char* argv[])
 {
     // Initialization
     //---------------------------------------------------------
@@ -61,104 +189,187 @@ int main(void)
     const int spacingRows = 4;
     const int spacingCols = 4;
 
+    // Maze size, render frame rate and items, command line options: -w <width> -h <height> -fps <rate> -vsync -items <count>
+    int mazeWidth = MAZE_WIDTH;
+    int mazeHeight = MAZE_HEIGHT;
+    int targetFps = 60;
+    bool vsync = false;
+    int itemCount = MAZE_ITEMS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-vsync") == 0) vsync = true;
+        else if (i + 1 >= argc) break;
+        else if (strcmp(argv[i], "-w") == 0) mazeWidth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-h") == 0) mazeHeight = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-fps") == 0) targetFps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-items") == 0) itemCount = atoi(argv[++i]);
+    }
+
+    // Maze size limited to grid max size, cell indices must fit in int
+    if (mazeWidth < MAZE_MIN_SIZE) mazeWidth = MAZE_MIN_SIZE;
+    else if (mazeWidth > MAZE_GRID_MAX_SIZE) mazeWidth = MAZE_GRID_MAX_SIZE;
+    if (mazeHeight < MAZE_MIN_SIZE) mazeHeight = MAZE_MIN_SIZE;
+    else if (mazeHeight > MAZE_GRID_MAX_SIZE) mazeHeight = MAZE_GRID_MAX_SIZE;
+
+    if (vsync) SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "raylib maze generator");
 
     // Current application mode
     int currentMode = 0;    // 0-Game2D, 1-Game3D, 2-Editor
 
     // Random seed defines the random numbers generation,
-    // always the same if using the same seed
+    // always the same maze and items if using the same seed
+    // NOTE: raylib global generator is only used to pick new random seeds
     SetRandomSeed(67218);
+    int mapRandomSeed = 67218;
 
-    // Generate maze image using the grid-based generator
+    // Startup loading: maze built and asset files decoded on worker threads, in parallel,
+    // main thread meanwhile opens audio device and loads the items model
+    // NOTE: Only GPU uploads and audio device data are loaded on main thread, once workers are done
+    double startupTime = GetTime();
+
+    // Generate maze grid using the grid-based generator, built on a worker thread (same as regenerated mazes)
     // DONE: [1p] Improve function to support extra configuration parameters 
-    Image imMaze = GenImageMaze(MAZE_WIDTH, MAZE_HEIGHT, spacingRows, spacingCols, 0.3f);
+    // NOTE: Maze grid is the map data for gameplay, maze image is only used to load GPU data
+    MazeBuild mazeBuild = { 0 };    // Maze built on a worker thread, on startup and on regenerate
+    mazeBuild.width = mazeWidth;
+    mazeBuild.height = mazeHeight;
+    mazeBuild.spacingRows = spacingRows;
+    mazeBuild.spacingCols = spacingCols;
+    mazeBuild.skipChance = 0.3f;
+    mazeBuild.seed = mapRandomSeed;
+    mazeBuild.itemCount = itemCount;
+    mazeBuild.screenSize = (Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() };
+
+    MazeThread* mazeBuildThread = LoadMazeThread(BuildMaze, &mazeBuild);
+    if (mazeBuildThread == NULL) BuildMaze(&mazeBuild);     // Thread could not be created, maze built on main thread
+
+    // Biomes atlas images and sound effects decoded on worker threads, one thread per file
+    // NOTE: Biomes first, then sounds: win, coin, die
+    AssetLoad assetLoads[4 + 3] = { 0 };
+    MazeThread* assetThreads[4 + 3] = { 0 };
+    int assetLoadsCount = sizeof(assetLoads) / sizeof(AssetLoad);
+    const char* soundFiles[3] = { "resources/fx_win.mp3", "resources/fx_coin.mp3", "resources/fx_die.mp3" };
+
+    for (int i = 0; i < assetLoadsCount; i++)
+    {
+        if (i < 4) strcpy(assetLoads[i].fileName, TextFormat("resources/maze_atlas%02d.png", i + 1));
+        else
+        {
+            strcpy(assetLoads[i].fileName, soundFiles[i - 4]);
+            assetLoads[i].type = 1;
+        }
 
-    // Load a texture to be drawn on screen from our image data
-    // WARNING: If imMaze pixel data is modified, texMaze needs to be re-loaded
-    Texture texMaze = LoadTextureFromImage(imMaze);
+        assetThreads[i] = LoadMazeThread(LoadAssetFile, &assetLoads[i]);
+        if (assetThreads[i] == NULL) LoadAssetFile(&assetLoads[i]);
+    }
+
+    // Audio device and music stream, audio device data only loaded on main thread
+    double audioTime = GetTime();
+    InitAudioDevice();
+    Music music = LoadMusicStream("resources/music_background.mp3"); // WAV not working
+    audioTime = GetTime() - audioTime;
 
-    // Generate 3D mesh from image and load a 3D model from mesh 
-    Mesh meshMaze = GenMeshCubicmap(imMaze, (Vector3) { 1.0f, 1.0f, 1.0f });
-    Model mdlMaze = LoadModelFromMesh(meshMaze);
-    Vector3 mdlPosition = { GetScreenWidth() / 2 - texMaze.width * MAZE_DRAW_SCALE / 2, GetScreenHeight() / 2 - texMaze.height * MAZE_DRAW_SCALE / 2 };  // Set model position
+    // NOTE: raylib parses and uploads models at once, model loaded on main thread
+    double modelTime = GetTime();
+    Model collectable3D = LoadModel("resources/mdl_pickup.glb");
+    modelTime = GetTime() - modelTime;
 
-    // Start and end cell positions (user defined)
-    Point startCells[4] = {
-        { 1, 1 },
-        { 1, 2 },
-        { 2, 1 },
-        { 2, 2 }
-    };
+    // Wait for workers, results only read once joined
+    double waitTime = GetTime();
+    for (int i = 0; i < assetLoadsCount; i++) UnloadMazeThread(assetThreads[i]);
+    UnloadMazeThread(mazeBuildThread);
+    mazeBuildThread = NULL;
+    waitTime = GetTime() - waitTime;
+    double uploadTime = GetTime();
 
-    Point endCells[4] = {
-        { imMaze.width - 3, imMaze.height - 3 },
-        { imMaze.width - 3, imMaze.height - 2 },
-        { imMaze.width - 2, imMaze.height - 3 },
-        { imMaze.width - 2, imMaze.height - 2 }
-    };
+    if (mazeBuild.fallback) TraceLog(LOG_WARNING, "MAZE: Maze %ix%i could not be generated, using default size", mazeWidth, mazeHeight);
 
-    int endCellsCount = sizeof(endCells) / sizeof(Point);
+    MazeGrid mazeGrid = mazeBuild.grid;
+    Image imMaze = mazeBuild.image;
 
-    // Player current position on image-coordinates
-    // WARNING: It could require conversion to world coordinates!
-    Point playerCell = startCells[0];
+    // Per-cell search data grows with maze size, only enabled up to a max size
+    bool mazeFieldEnabled = ((size_t)mazeGrid.width * mazeGrid.height <= MAZE_FIELD_MAX_CELLS);
+
+    // Load a texture to be drawn on screen from our image data
+    // WARNING: If imMaze pixel data is modified, texMaze needs to be re-loaded
+    Texture texMaze = LoadTextureFromImage(imMaze);
+
+    // Load 3D model from maze grid, split in chunk meshes generated by maze build worker (small mazes)
+    // NOTE: Chunks generated when first drawn, map edits only generate again touched chunks
+    MazeModel mdlMaze = (mazeBuild.chunkMeshes != NULL)? LoadMazeModelFromMeshes(mazeGrid, mazeBuild.chunkMeshes) : LoadMazeModel(mazeGrid);
+    Vector3 mdlPosition = mazeBuild.origin;     // Set model position, maze centered on screen
+    free(mazeBuild.chunkMeshes);
+
+    // 3d view potentially visible cells, only visible chunks and items are drawn
+    // NOTE: Visibility data only covers cells around the view (camera far plane), any maze size supported
+    MazeVisibility mazeVisibility = LoadMazeVisibility(mazeGrid.width, mazeGrid.height, MAZE_MESH_CHUNK_SIZE);
+
+    // Game simulation: player, items, score and time limit, updated from player input every frame
+    // NOTE: Start and end cells are defined by simulation, player start cell and maze opposite corner
+    MazeSim sim = mazeBuild.sim;
+    int endCellsCount = sizeof(sim.endCells) / sizeof(Point);
+
+    // Maze connected regions: end cells reachable check, items placed only on cells reachable from start
+    // NOTE: Updated in place on map edits, labelled again once painting ends if a region could be split,
+    // not available for big mazes (repair uses per-cell data)
+    MazeRegions mazeRegions = mazeBuild.regions;
+    MazeGrid itemsGrid = mazeBuild.itemsGrid;
+    bool mazeConnected = mazeBuild.connected;
+    bool regionsDirty = false;
+    double regionsTime = 0.0;
+    int repairWallCount = 0;
 
     // Camera 2D for 2d gameplay mode
     // DONE: Initialize camera parameters as required
     Camera2D camera2d = { 0 };
-    camera2d.target = (Vector2){ mdlPosition.x + playerCell.x * MAZE_DRAW_SCALE, mdlPosition.y + playerCell.y * MAZE_DRAW_SCALE };
+    camera2d.target = (Vector2){ mdlPosition.x + sim.playerCell.x * MAZE_DRAW_SCALE, mdlPosition.y + sim.playerCell.y * MAZE_DRAW_SCALE };
     camera2d.offset = (Vector2){ GetScreenWidth() / 2, GetScreenHeight() / 2 };
     camera2d.rotation = 0.0f;
     camera2d.zoom = 1.0f;
 
-    // Camera 3D for first-person gameplay mode
-    // DONE: Initialize camera parameters as required
-    // NOTE: In a first-person mode, camera.position is actually the player position
-    // REMEMBER: We are using a different coordinates space than 2d mode
-    Camera cameraFP = { 0 };
-    cameraFP.position = (Vector3){ mdlPosition.x + playerCell.x, mdlPosition.y + 0.3f, mdlPosition.z + playerCell.y };
-    cameraFP.target = (Vector3){ cameraFP.position.x + 1.0f, cameraFP.position.y, cameraFP.position.z + 1.0f };
-    cameraFP.up = (Vector3){ 0.0f, 1.0f, 0.0f };
-    cameraFP.fovy = 45.0f;
-    cameraFP.projection = CAMERA_PERSPECTIVE;
-    Color* mapPixels = LoadImageColors(imMaze);
+    // Camera 2D for editor mode, big mazes are zoomed and panned
+    // NOTE: Default view draws the maze centered on screen at MAZE_DRAW_SCALE
+    Camera2D cameraEditor = { 0 };
+    cameraEditor.target = (Vector2){ GetScreenWidth() / 2, GetScreenHeight() / 2 };
+    cameraEditor.offset = (Vector2){ GetScreenWidth() / 2, GetScreenHeight() / 2 };
+    cameraEditor.rotation = 0.0f;
+    cameraEditor.zoom = 1.0f;
 
     // Mouse selected cell for maze editing
     Point selectedCell = { 0 };
 
-    // Maze items position and state
-    CollectibleItem collectibleItems[MAX_MAZE_ITEMS];
-    int playerScore = 0;
-
-    // Generate random collectible items in the maze
-    SetCollectibleItems(imMaze, startCells, endCells, collectibleItems);
-
     // Define textures to be used as our "biomes"
     // DONE: Load additional textures for different biomes
     Texture2D texBiomes[4] = { 0 };
     int texBiomesCount = sizeof(texBiomes) / sizeof(Texture2D);
     for (int i = 0; i < texBiomesCount; i++)
     {
-        texBiomes[i] = LoadTexture(TextFormat("resources/maze_atlas%02d.png", i + 1));
+        texBiomes[i] = LoadTextureFromImage(assetLoads[i].image);    // Image decoded on startup worker
+        UnloadImage(assetLoads[i].image);
     }
 
     int currentBiome = 0;
-    mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+    mdlMaze.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
 
-    // Background music
-    InitAudioDevice();
+    // 2d maze tiles cached on render textures, only drawn again on map edits or biome change
+    // NOTE: Enough chunks cached for the biggest view, screen at min zoom
+    Vector2 layerMaxView = { GetScreenWidth() / GAME_CAMERA_MIN_ZOOM, GetScreenHeight() / GAME_CAMERA_MIN_ZOOM };
+    MazeLayer mazeLayer = LoadMazeLayer(mazeGrid.width, mazeGrid.height, MAZE_DRAW_SCALE, texBiomes[currentBiome], layerMaxView);
+
+    // Background music, audio device and music stream loaded on startup
     float masterVolume = 0.5f;
     bool pause = false;
 
-    Music music = LoadMusicStream("resources/music_background.mp3"); // WAV not working
     PlayMusicStream(music);
     SetMusicVolume(music, masterVolume);
 
-    // Audio fx
-    Sound fxWin = LoadSound("resources/fx_win.mp3");
-    Sound fxCoin = LoadSound("resources/fx_coin.mp3");
-    Sound fxDie = LoadSound("resources/fx_die.mp3");
+    // Audio fx, waves decoded on startup workers
+    Sound fxWin = LoadSoundFromWave(assetLoads[4].wave);
+    Sound fxCoin = LoadSoundFromWave(assetLoads[5].wave);
+    Sound fxDie = LoadSoundFromWave(assetLoads[6].wave);
+    for (int i = 4; i < assetLoadsCount; i++) UnloadWave(assetLoads[i].wave);
     SetSoundVolume(fxWin, masterVolume);
     SetSoundVolume(fxCoin, masterVolume);
     SetSoundVolume(fxDie, masterVolume);
@@ -167,16 +378,86 @@ int main(void)
 
     // DONE: Define all variables required for game UI elements (sprites, fonts...)
     bool drawPathAStar = false;
-    int remainingTime = TIME_LIMIT_SECONDS;
-    Model collectable3D = LoadModel("resources/mdl_pickup.glb");
+
+    // Distance from every cell to the nearest end cell, game modes paths are walked on it
+    // NOTE: Only recomputed when maze image changes and a game mode path is drawn, not available for big mazes
+    DistanceField goalField = mazeBuild.goalField;
+    bool goalFieldDirty = false;
+
+    // Path planner keeps the editor path between frames, repaired on map edits
+    PathPlanner editorPathPlanner = mazeBuild.planner;
+
+    // Path graph for hierarchical searches, clusters built on first search,
+    // only clusters touched by map edits are rebuilt
+    PathGraph mazePathGraph = mazeBuild.pathGraph;
+
+    // Game path for big mazes (no distance field), searched from player cell when path drawing is enabled
+    // NOTE: Path is followed while player moves along it, only drawn from player point to end
+    Point* gamePath = NULL;
+    int gamePathPointCount = 0;
+    int gamePathPlayerIndex = 0;    // Player point in game path, path points stored from end to start
+    bool gamePathDirty = true;
+
+    // Big mazes paths searched on a worker thread, one query at a time, game keeps running meanwhile
+    // NOTE: Last found paths are drawn until the new ones are found
+    PathQuery pathQuery = { 0 };
+    MazeThread* pathQueryThread = NULL;
+
+    // Editor path search selection and last search info
+    // NOTE: Editor path is only searched again after map changes or search mode changes
+    int pathSearchMode = 0;         // 0-D* Lite planner, 1-A*, 2-Jump Point Search, 3-HPA*
+    Point* editorPath = NULL;
+    int editorPathMode = -1;
+    bool editorPathDirty = true;
+    int pathPointCount = 0;
+    int pathExpandedCount = 0;
+    double pathSearchTime = 0.0;
+
+    // Items 3d models drawn instanced, one draw per model mesh for all visible items
+    PickupBatch pickupBatch = LoadPickupBatch(collectable3D, itemCount);
 
     // DONE: Define all variables required for UI editor (raygui)
     int mapRowSpacing = 4;
     int mapColumnSpacing = 4;
-    int mapRandomSeed = 67218;
     float mapPointsSkipChance = 0.3f;
+    int mapWidth = mazeGrid.width;
+    int mapHeight = mazeGrid.height;
+    bool mapWidthEditMode = false;
+    bool mapHeightEditMode = false;
+    bool mapRegenerate = false;     // Maze regenerated on next frame update, requested by UI
+    bool mazeBuilding = false;      // New maze building on a worker thread (mazeBuild), current maze used until build is done
+    bool mapRepair = false;         // Maze walls removed to connect start and end cells on next frame update, requested by UI
+
+    // Fixed timestep: game simulation advances in steps of the same time whatever the frame rate,
+    // rendering interpolates player and camera between the last two steps
+    const float stepTime = 1.0f / GAME_STEP_RATE;
+    float stepAccumulator = 0.0f;
+    float stepBlend = 1.0f;         // Render position between previous (0.0f) and current (1.0f) step
+    Point prevPlayerCell = sim.playerCell;
+    Camera prevCamera = sim.camera;
+    Vector2 pendingLook = { 0 };    // Mouse view rotation not yet applied by a simulation step
+    bool cameraSnap = true;         // Camera 2D moved to player without smoothing (game restarted)
+
+    // Startup timings, worker threads times overlap main thread ones
+    double assetsTime = 0.0;
+    double assetsMaxTime = 0.0;
+
+    for (int i = 0; i < assetLoadsCount; i++)
+    {
+        assetsTime += assetLoads[i].loadTime;
+        if (assetLoads[i].loadTime > assetsMaxTime) assetsMaxTime = assetLoads[i].loadTime;
+    }
+
+    uploadTime = GetTime() - uploadTime;
 
-    SetTargetFPS(60);       // Set our game to run at 60 frames-per-second
+    TraceLog(LOG_INFO, "STARTUP: Maze %ix%i build: %.1f ms (worker thread)", mazeGrid.width, mazeGrid.height, mazeBuild.buildTime * 1000.0);
+    TraceLog(LOG_INFO, "STARTUP: Assets decode: %.1f ms on %i worker threads (longest %.1f ms)", assetsTime * 1000.0, assetLoadsCount, assetsMaxTime * 1000.0);
+    TraceLog(LOG_INFO, "STARTUP: Audio device and music: %.1f ms, items model: %.1f ms (main thread)", audioTime * 1000.0, modelTime * 1000.0);
+    TraceLog(LOG_INFO, "STARTUP: Workers wait: %.1f ms, GPU uploads and game init: %.1f ms", waitTime * 1000.0, uploadTime * 1000.0);
+    TraceLog(LOG_INFO, "STARTUP: First frame after %.1f ms (%.1f ms of work)", (GetTime() - startupTime) * 1000.0,
+        (mazeBuild.buildTime + assetsTime + audioTime + modelTime + uploadTime) * 1000.0);
+
+    SetTargetFPS(targetFps);        // Set our game to render at target frames-per-second (0-Uncapped), game simulation runs at GAME_STEP_RATE
     //--------------------------------------------------------------------------------------
 
     // Main game loop
@@ -188,169 +469,272 @@ int main(void)
         // Update music stream buffer
         UpdateMusicStream(music);
 
-        // Select current mode as desired
-        if (IsKeyPressed(KEY_Z)) currentMode = 0;       // Game 2D mode
-        else if (IsKeyPressed(KEY_X)) currentMode = 1;  // Game 3D mode
-        else if (IsKeyPressed(KEY_C)) currentMode = 2;  // Editor mode
-
-        if (IsKeyPressed(KEY_SPACE)) drawPathAStar = !drawPathAStar;
-
-        switch (currentMode)
-        {
-        case 0:     // Game 2D mode
+        // Regenerate maze with current map configuration on a worker thread, maze size could change
+        // NOTE: Game keeps running on current maze while the new one is built
+        if (mapRegenerate && !mazeBuilding)
         {
-            ShowCursor();
-
-            // DONE: [2p] Player 2D movement from predefined start point (A) to end point (B)
-            Point prevplayerCell = playerCell;
-
-            // Implement maze 2D player movement logic (cursors || WASD)
-            if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) playerCell.y -= 1;
-            if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) playerCell.y += 1;
-            if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) playerCell.x -= 1;
-            if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) playerCell.x += 1;
+            mazeBuild = (MazeBuild){ 0 };
+            mazeBuild.width = mapWidth;
+            mazeBuild.height = mapHeight;
+            mazeBuild.spacingRows = mapRowSpacing;
+            mazeBuild.spacingCols = mapColumnSpacing;
+            mazeBuild.skipChance = mapPointsSkipChance;
+            mazeBuild.seed = mapRandomSeed;
+            mazeBuild.itemCount = itemCount;
+            mazeBuild.screenSize = (Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() };
+
+            mazeBuildThread = LoadMazeThread(BuildMaze, &mazeBuild);
+            if (mazeBuildThread == NULL) BuildMaze(&mazeBuild);     // Thread could not be created, maze built on main thread
+
+            mazeBuilding = true;
+            mapRegenerate = false;
+        }
 
-            // Use imMaze pixel information to check collisions
-            if (GetImageColor(imMaze, playerCell.x, playerCell.y).r == 255) playerCell = prevplayerCell;
+        // New maze built, current maze data replaced at once, only GPU data loaded here
+        // NOTE: Path query worker uses current maze path graph, maze replaced once query is done
+        if (mazeBuilding && IsMazeThreadDone(mazeBuildThread) && !pathQuery.searching)
+        {
+            UnloadMazeThread(mazeBuildThread);
+            mazeBuildThread = NULL;
+            mazeBuilding = false;
 
-            // Detect if current playerCell == endCell to finish game
-            for (int i = 0; i < endCellsCount; i++)
+            if (mazeBuild.fallback)
             {
-                if (playerCell.x == endCells[i].x && playerCell.y == endCells[i].y)
-                {
-                    remainingTime = TIME_LIMIT_SECONDS; // Reset remaining time
-                    playerCell = startCells[0];      // Reset player 2D position
-                    cameraFP.position = (Vector3){ mdlPosition.x + playerCell.x, mdlPosition.y + 0.3f, mdlPosition.z + playerCell.y }; // Reset camera 3D position
-                    playerScore = 0; // Reset player score
-                    SetCollectibleItems(imMaze, startCells, endCells, collectibleItems); // Reset collectible items
-                    PlaySound(fxWin);
-                }
+                TraceLog(LOG_WARNING, "MAZE: Maze %ix%i could not be generated, using default size", mapWidth, mapHeight);
+                mapWidth = MAZE_WIDTH;
+                mapHeight = MAZE_HEIGHT;
             }
 
-            // DONE: [2p] Camera 2D system following player movement around the map
-            // Update Camera2D parameters as required to follow player and zoom control
-            camera2d.target = (Vector2){ mdlPosition.x + playerCell.x * MAZE_DRAW_SCALE, mdlPosition.y + playerCell.y * MAZE_DRAW_SCALE };
-            camera2d.zoom += ((float)GetMouseWheelMove() * 0.5f);
+            TraceLog(LOG_INFO, "MAZE: Maze %ix%i built in %.1f ms (worker thread)", mazeBuild.grid.width, mazeBuild.grid.height, mazeBuild.buildTime * 1000.0);
 
-            // Update 3d camera position (to stay in sync with 2d camera when changing mode)
-            cameraFP.position = (Vector3){ mdlPosition.x + playerCell.x, mdlPosition.y + 0.3f, mdlPosition.z + playerCell.y };
+            UnloadMazeGrid(mazeGrid);
+            mazeGrid = mazeBuild.grid;
 
-            // Camera zoom
-            if (camera2d.zoom > 6.0f) camera2d.zoom = 6.0f;
-            else if (camera2d.zoom < 0.2f) camera2d.zoom = 0.2f;
+            mazeFieldEnabled = ((size_t)mazeGrid.width * mazeGrid.height <= MAZE_FIELD_MAX_CELLS);
+
+            UnloadImage(imMaze);
+            imMaze = mazeBuild.image;
 
-            // DONE: Maze items pickup logic
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++)
+            // Texture only reloaded if maze size changed
+            if ((texMaze.width != imMaze.width) || (texMaze.height != imMaze.height))
             {
-                if (!collectibleItems[i].collected && (playerCell.x == collectibleItems[i].position.x) && (playerCell.y == collectibleItems[i].position.y))
-                {
-                    collectibleItems[i].collected = true;
-                    playerScore += collectibleItems[i].value;
-                    PlaySound(fxCoin);
-                }
+                UnloadTexture(texMaze);
+                texMaze = LoadTextureFromImage(imMaze);
             }
+            else UpdateTexture(texMaze, imMaze.data);
+
+            mdlPosition = mazeBuild.origin;
+
+            UnloadMazeLayer(mazeLayer);
+            mazeLayer = LoadMazeLayer(mazeGrid.width, mazeGrid.height, MAZE_DRAW_SCALE, texBiomes[currentBiome], layerMaxView);
+
+            // Update 3d model, chunk meshes generated by worker are uploaded
+            UnloadMazeModel(mdlMaze);
+            mdlMaze = (mazeBuild.chunkMeshes != NULL)? LoadMazeModelFromMeshes(mazeGrid, mazeBuild.chunkMeshes) : LoadMazeModel(mazeGrid);
+            mdlMaze.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            free(mazeBuild.chunkMeshes);
+
+            UnloadMazeVisibility(mazeVisibility);
+            mazeVisibility = LoadMazeVisibility(mazeGrid.width, mazeGrid.height, MAZE_MESH_CHUNK_SIZE);
+
+            // Restart game on new maze, same seed always places the same items
+            UnloadMazeSim(sim);
+            sim = mazeBuild.sim;
+
+            UnloadMazeRegions(mazeRegions);
+            UnloadMazeGrid(itemsGrid);
+            mazeRegions = mazeBuild.regions;
+            itemsGrid = mazeBuild.itemsGrid;
+            mazeConnected = mazeBuild.connected;
+            regionsDirty = false;
+            repairWallCount = 0;
+
+            prevPlayerCell = sim.playerCell;
+            prevCamera = sim.camera;
+            cameraSnap = true;
+
+            UnloadDistanceField(goalField);
+            goalField = mazeBuild.goalField;
+            goalFieldDirty = false;
+
+            UnloadPathPlanner(editorPathPlanner);
+            editorPathPlanner = mazeBuild.planner;
+
+            UnloadPathGraph(mazePathGraph);
+            mazePathGraph = mazeBuild.pathGraph;
+
+            // Paths of previous maze not drawn, big mazes paths take a while to be found again
+            free(editorPath);
+            editorPath = NULL;
+            pathPointCount = 0;
+            free(gamePath);
+            gamePath = NULL;
+            gamePathPointCount = 0;
+            gamePathPlayerIndex = 0;
+            editorPathDirty = true;
+            gamePathDirty = true;
+        }
 
-            // Time limit logic
-            remainingTime -= GetFrameTime() * 1000;
+        // Remove min walls required to connect start and end cells, map updated as on editor edits
+        if (mapRepair)
+        {
+            Point* walls = RepairMazeRegions(&mazeRegions, &mazeGrid, sim.startCells[0], sim.endCells[3], &repairWallCount);
+            unsigned char pixelValue = 0;   // Maze image is GRAYSCALE
 
-            if (remainingTime <= 0)
+            for (int i = 0; i < repairWallCount; i++)
             {
-                remainingTime = TIME_LIMIT_SECONDS; // Reset remaining time
-                playerCell = startCells[0];      // Reset player 2D position
-                cameraFP.position = (Vector3){ mdlPosition.x + playerCell.x, mdlPosition.y + 0.3f, mdlPosition.z + playerCell.y }; // Reset camera 3D position
-                playerScore = 0; // Reset player score
-                SetCollectibleItems(imMaze, startCells, endCells, collectibleItems); // Reset collectible items
-                PlaySound(fxDie);
+                ImageDrawPixel(&imMaze, walls[i].x, walls[i].y, BLACK);
+                UpdateTextureRec(texMaze, (Rectangle){ (float)walls[i].x, (float)walls[i].y, 1, 1 }, &pixelValue);
+                SetMazeLayerCellDirty(&mazeLayer, walls[i]);
+                SetMazeModelCellDirty(&mdlMaze, walls[i]);
+                UpdatePathQueryCell(&pathQuery, &mazePathGraph, mazeGrid, walls[i]);
+                UpdatePathPlannerCell(&editorPathPlanner, mazeGrid, walls[i]);
             }
 
-            } break;
-        case 1:     // Game 3D mode
-        {
-            // DONE: [1p] Camera 3D system and 3D maze mode
-            // Implement maze 3d first-person mode -> TIP: UpdateCamera()
-            // Use the imMaze map to implement collision detection, similar to 2D
-            Vector3 oldCamPos = cameraFP.position;
-            UpdateCamera(&cameraFP, CAMERA_FIRST_PERSON);
-            DisableCursor();
+            if (repairWallCount > 0)
+            {
+                goalFieldDirty = true;
+                mazeConnected = UpdateMazeReachability(&mazeRegions, &itemsGrid, mazeGrid, sim.startCells[0], sim.endCells);
+                regionsDirty = false;
+                editorPathDirty = true;
+                gamePathDirty = true;
+            }
+
+            free(walls);
+            mapRepair = false;
+        }
 
-            Vector2 playerPos = { cameraFP.position.x, cameraFP.position.z };
-            float playerRadius = 0.1f;
+        // Select current mode as desired
+        if (IsKeyPressed(KEY_Z)) currentMode = 0;       // Game 2D mode
+        else if (IsKeyPressed(KEY_X)) currentMode = 1;  // Game 3D mode
+        else if (IsKeyPressed(KEY_C)) currentMode = 2;  // Editor mode
 
-            int playerCellX = (int)(playerPos.x - mdlPosition.x + 0.5f);
-            int playerCellY = (int)(playerPos.y - mdlPosition.z + 0.5f);
+        if (IsKeyPressed(KEY_SPACE))
+        {
+            drawPathAStar = !drawPathAStar;
+            gamePathDirty = true;
+        }
 
-            // Out-of-limits check
-            if (playerCellX < 0) playerCellX = 0;
-            else if (playerCellX >= texMaze.width) playerCellX = texMaze.width - 1;
+        // Game simulation steps for frame time, only in game modes
+        // NOTE: Input is read once per frame and used by all steps of the frame, mouse view rotation by the first one
+        int simEvents = 0;
 
-            if (playerCellY < 0) playerCellY = 0;
-            else if (playerCellY >= texMaze.height) playerCellY = texMaze.height - 1;
+        if (currentMode != 2)
+        {
+            sim.mode = currentMode;
 
-            // Check map collisions using image data and player position
-            // DONE: Improvement: Just check player surrounding cells for collision
-            for (int y = 0; y < texMaze.height; y++)
+            if (sim.mode == 1)
             {
-                for (int x = 0; x < texMaze.width; x++)
-                {
-                    if ((mapPixels[y * texMaze.width + x].r == 255) &&
-                        (CheckCollisionCircleRec(playerPos, playerRadius, (Rectangle) { mdlPosition.x - 0.5f + x * 1.0f, mdlPosition.z - 0.5f + y * 1.0f, 1.0f, 1.0f })))
-                    {
-                        cameraFP.position = oldCamPos;
-                    }
-                }
+                Vector2 mouseDelta = GetMouseDelta();
+                pendingLook.x += mouseDelta.x * 0.003f * RAD2DEG;
+                pendingLook.y += mouseDelta.y * 0.003f * RAD2DEG;
             }
 
-            playerCell = (Point){ playerCellX, playerCellY };
+            stepAccumulator += GetFrameTime();
 
-            // DONE: Maze items pickup logic
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++)
+            for (int step = 0; stepAccumulator >= stepTime; step++)
             {
-                if (!collectibleItems[i].collected && (playerCell.x == collectibleItems[i].position.x) && (playerCell.y == collectibleItems[i].position.y))
+                // Frames too slow to catch up: game time is dropped instead of running more steps
+                if (step == GAME_MAX_STEPS_PER_FRAME)
                 {
-                    collectibleItems[i].collected = true;
-                    playerScore += collectibleItems[i].value;
-                    PlaySound(fxCoin);
+                    stepAccumulator = 0.0f;
+                    break;
                 }
-            }
 
-            // Check if player reaches the end cell
-            for (int i = 0; i < endCellsCount; i++)
-            {
-                if (playerCell.x == endCells[i].x && playerCell.y == endCells[i].y)
+                MazeSimInput input = GetMazeSimInput(sim.mode, stepTime);
+                input.look.x += pendingLook.x;
+                input.look.y += pendingLook.y;
+                pendingLook = (Vector2){ 0 };
+
+                prevPlayerCell = sim.playerCell;
+                prevCamera = sim.camera;
+
+                int stepEvents = UpdateMazeSim(&sim, input, stepTime);
+
+                // Game restarted: player moved to start cell, no interpolation
+                if (stepEvents & (MAZE_SIM_EVENT_WIN | MAZE_SIM_EVENT_TIMEOUT))
                 {
-                    // Player reached the end cell, restart the game
-                    remainingTime = TIME_LIMIT_SECONDS;
-                    playerCell = startCells[0];
-                    cameraFP.position = (Vector3){ mdlPosition.x + playerCell.x, mdlPosition.y + 0.3f, mdlPosition.z + playerCell.y };
-                    playerScore = 0;
-                    SetCollectibleItems(imMaze, startCells, endCells, collectibleItems);
-                    PlaySound(fxWin);
+                    prevPlayerCell = sim.playerCell;
+                    prevCamera = sim.camera;
+                    cameraSnap = true;
                 }
+
+                simEvents |= stepEvents;
+                stepAccumulator -= stepTime;
             }
 
-            // Time limit logic
-            remainingTime -= GetFrameTime() * 1000;
+            stepBlend = stepAccumulator / stepTime;
+        }
+        else stepAccumulator = 0.0f;
+
+        // Player interpolated render position, in 2d world units
+        Vector2 playerPosition = {
+            mdlPosition.x + (prevPlayerCell.x + (sim.playerCell.x - prevPlayerCell.x) * stepBlend) * MAZE_DRAW_SCALE,
+            mdlPosition.y + (prevPlayerCell.y + (sim.playerCell.y - prevPlayerCell.y) * stepBlend) * MAZE_DRAW_SCALE
+        };
+
+        switch (currentMode)
+        {
+        case 0:     // Game 2D mode
+        {
+            ShowCursor();
+
+            // DONE: [2p] Player 2D movement from predefined start point (A) to end point (B)
+            // Implement maze 2D player movement logic (cursors || WASD)
+            // NOTE: Movement, collisions, items pickup, end cells and time limit are updated by game simulation steps
 
-            if (remainingTime <= 0)
+            // DONE: [2p] Camera 2D system following player movement around the map
+            // Update Camera2D parameters as required to follow player and zoom control
+            // NOTE: Camera smoothly follows player interpolated position, frame rate independent
+            if (cameraSnap) camera2d.target = playerPosition;
+            else
             {
-                remainingTime = TIME_LIMIT_SECONDS;
-                playerCell = startCells[0];
-                cameraFP.position = (Vector3){ mdlPosition.x + playerCell.x, mdlPosition.y + 0.3f, mdlPosition.z + playerCell.y };
-                playerScore = 0;
-                SetCollectibleItems(imMaze, startCells, endCells, collectibleItems);
-                PlaySound(fxDie);
-            };
+                float follow = 1.0f - expf(-GAME_CAMERA_FOLLOW_SPEED * GetFrameTime());
+                camera2d.target.x += (playerPosition.x - camera2d.target.x) * follow;
+                camera2d.target.y += (playerPosition.y - camera2d.target.y) * follow;
+            }
+
+            cameraSnap = false;
+            camera2d.zoom += ((float)GetMouseWheelMove() * 0.5f);
+
+            // Camera zoom
+            if (camera2d.zoom > 6.0f) camera2d.zoom = 6.0f;
+            else if (camera2d.zoom < GAME_CAMERA_MIN_ZOOM) camera2d.zoom = GAME_CAMERA_MIN_ZOOM;
+
+            } break;
+        case 1:     // Game 3D mode
+        {
+            // DONE: [1p] Camera 3D system and 3D maze mode
+            // Implement maze 3d first-person mode -> TIP: UpdateCamera()
+            // Use the maze grid to implement collision detection, similar to 2D
+            // NOTE: Simulation camera is the player, moved by game simulation steps from first-person input
+            DisableCursor();
+            cameraSnap = true;
 
         } break;
         case 2:     // Editor mode
         {
             ShowCursor();
 
+            // Editor camera: mouse wheel zoom, cursors/WASD pan
+            float editorMinZoom = 0.5f * (float)GetScreenHeight() / (((mazeGrid.width > mazeGrid.height)? mazeGrid.width : mazeGrid.height) * MAZE_DRAW_SCALE);
+            if (editorMinZoom > 0.5f) editorMinZoom = 0.5f;
+
+            cameraEditor.zoom *= (1.0f + (float)GetMouseWheelMove() * 0.1f);
+            if (cameraEditor.zoom > 6.0f) cameraEditor.zoom = 6.0f;
+            else if (cameraEditor.zoom < editorMinZoom) cameraEditor.zoom = editorMinZoom;
+
+            float editorPanSpeed = 600.0f * GetFrameTime() / cameraEditor.zoom;
+            if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) cameraEditor.target.y -= editorPanSpeed;
+            if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) cameraEditor.target.y += editorPanSpeed;
+            if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) cameraEditor.target.x -= editorPanSpeed;
+            if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) cameraEditor.target.x += editorPanSpeed;
+
             // DONE: [2p] Visual map editor mode. Edit image pixels with mouse.
-            // Check mouse position and update selected cell
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
+            // Check mouse position and update selected cell, cells painted while dragging
+            if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsMouseButtonDown(MOUSE_RIGHT_BUTTON))
             {
-                Vector2 mousePos = GetMousePosition();
+                Vector2 mousePos = GetScreenToWorld2D(GetMousePosition(), cameraEditor);
 
                 // Mouse position to image coordinates
                 selectedCell.x = (int)((mousePos.x - mdlPosition.x) / MAZE_DRAW_SCALE);
@@ -358,17 +742,38 @@ int main(void)
 
                 // Check if the selected cell is int the maze
                 // +-1 to avoid drawing on the border
-                if (selectedCell.x >= 1 && selectedCell.x < imMaze.width - 1 &&
-                    selectedCell.y >= 1 && selectedCell.y < imMaze.height - 1)
+                // Only cells changing state are updated, dragging over painted cells does nothing
+                bool paintWall = !IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+
+                if (selectedCell.x >= 1 && selectedCell.x < mazeGrid.width - 1 &&
+                    selectedCell.y >= 1 && selectedCell.y < mazeGrid.height - 1 &&
+                    (IsMazeGridWall(mazeGrid, selectedCell.x, selectedCell.y) != paintWall))
                 {
-                    // Set pixel color based on mouse button
-                    Color pixelColor = IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ? BLACK : WHITE;
+                    // Set cell and pixel color based on mouse button, maze grid and image must be kept in sync
+                    Color pixelColor = paintWall ? WHITE : BLACK;
+                    unsigned char pixelValue = paintWall ? 255 : 0;     // Maze image is GRAYSCALE
+                    SetMazeGridCell(&mazeGrid, selectedCell.x, selectedCell.y, paintWall);
                     ImageDrawPixel(&imMaze, selectedCell.x, selectedCell.y, pixelColor);
+                    SetMazeLayerCellDirty(&mazeLayer, selectedCell);
+                    SetMazeModelCellDirty(&mdlMaze, selectedCell);
+                    UpdatePathQueryCell(&pathQuery, &mazePathGraph, mazeGrid, selectedCell);
+
+                    if (mazeFieldEnabled)
+                    {
+                        UpdatePathPlannerCell(&editorPathPlanner, mazeGrid, selectedCell);
+
+                        // Regions updated on edited cell, edits can close or open paths to end cells
+                        double regionsStartTime = GetTime();
+                        mazeConnected = UpdateMazeReachabilityCell(&mazeRegions, &itemsGrid, mazeGrid, sim.startCells[0], sim.endCells, selectedCell, &regionsDirty);
+                        regionsTime = GetTime() - regionsStartTime;
+                    }
+
+                    editorPathDirty = true;
+                    gamePathDirty = true;
+                    goalFieldDirty = true;
 
-                    UpdateTexture(texMaze, imMaze.data);
-                    UnloadMesh(meshMaze);
-                    meshMaze = GenMeshCubicmap(imMaze, (Vector3) { 1.0f, 1.0f, 1.0f });
-                    mapPixels = LoadImageColors(imMaze);
+                    // Only edited pixel is uploaded, full texture upload is slow for big mazes
+                    UpdateTextureRec(texMaze, (Rectangle){ (float)selectedCell.x, (float)selectedCell.y, 1, 1 }, &pixelValue);
                 }
             }
 
@@ -378,50 +783,176 @@ int main(void)
 
             if (IsMouseButtonPressed(MOUSE_MIDDLE_BUTTON))
             {
-                Vector2 mousePos = GetMousePosition();
+                Vector2 mousePos = GetScreenToWorld2D(GetMousePosition(), cameraEditor);
 
                 selectedCell.x = (int)((mousePos.x - mdlPosition.x) / MAZE_DRAW_SCALE);
                 selectedCell.y = (int)((mousePos.y - mdlPosition.y) / MAZE_DRAW_SCALE);
 
-                // If the selected cell is not a wall, add the item
-                if (GetImageColor(imMaze, selectedCell.x, selectedCell.y).r == 0)
+                // If the selected cell is not a wall and has no item, add the item
+                if (IsCellWalkable(mazeGrid, selectedCell.x, selectedCell.y) && (GetCollectibleItemIndex(sim.items, selectedCell) == -1))
                 {
-                    // Choose a random item of the collectible items array
-                    int item = GetRandomValue(0, MAX_MAZE_ITEMS - 1);
+                    // Items store full, a random item is moved to selected cell
+                    if (sim.items.count == sim.items.capacity) RemoveCollectibleItem(&sim.items, GetMazeRandomValue(&sim.itemsRandom, 0, sim.items.count - 1));
 
-                    // Add item to the collectible items array
-                    collectibleItems[item].position = selectedCell;
-                    UnloadMesh(meshMaze);
-                    meshMaze = GenMeshCubicmap(imMaze, (Vector3) { 1.0f, 1.0f, 1.0f });
+                    // Add item to the collectible items store
+                    AddCollectibleItem(&sim.items, GenCollectibleItem(&sim.itemsRandom, selectedCell));
                 }
             }
+
+            // Per-cell searches not available for big mazes, hierarchical search only (path query worker)
+            if (!mazeFieldEnabled) pathSearchMode = 3;
+
+            // Search editor path again only if map or search mode changed
+            if (drawPathAStar && mazeFieldEnabled && (editorPathDirty || (pathSearchMode != editorPathMode)))
+            {
+                double searchStartTime = GetTime();
+
+                free(editorPath);
+                editorPath = NULL;
+
+                if (pathSearchMode == 1) editorPath = LoadPathAStar(mazeGrid, sim.startCells[0], sim.endCells[3], &pathPointCount);
+                else if (pathSearchMode == 2) editorPath = LoadPathJPS(mazeGrid, sim.startCells[0], sim.endCells[3], &pathPointCount);
+                else if (pathSearchMode == 3) editorPath = LoadPathHPA(&mazePathGraph, mazeGrid, sim.startCells[0], sim.endCells[3], &pathPointCount);
+                else
+                {
+                    // Planner path is owned by the planner, a copy is kept
+                    const Point* plannerPath = UpdatePathPlanner(&editorPathPlanner, mazeGrid, sim.startCells[0], sim.endCells[3], &pathPointCount);
+
+                    if (pathPointCount > 0)
+                    {
+                        editorPath = (Point*)malloc(pathPointCount * sizeof(Point));
+                        memcpy(editorPath, plannerPath, pathPointCount * sizeof(Point));
+                    }
+                }
+
+                pathSearchTime = GetTime() - searchStartTime;
+                pathExpandedCount = (pathSearchMode == 0)? 0 : GetPathSearchExpandedCount();
+                editorPathMode = pathSearchMode;
+                editorPathDirty = false;
+            }
         } break;
         default: break;
         }
 
+        if (simEvents & MAZE_SIM_EVENT_ITEM) PlaySound(fxCoin);
+        if (simEvents & MAZE_SIM_EVENT_WIN) PlaySound(fxWin);
+        if (simEvents & MAZE_SIM_EVENT_TIMEOUT) PlaySound(fxDie);
+
+        bool editorPainting = (currentMode == 2) && (IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsMouseButtonDown(MOUSE_RIGHT_BUTTON));
+
+        // Regions possibly split by painted walls labelled again once, when painting ends
+        if (regionsDirty && !editorPainting)
+        {
+            double regionsStartTime = GetTime();
+            mazeConnected = UpdateMazeReachability(&mazeRegions, &itemsGrid, mazeGrid, sim.startCells[0], sim.endCells);
+            regionsTime = GetTime() - regionsStartTime;
+            regionsDirty = false;
+        }
+
+        // Distance field computed again only when game modes path is drawn, editor edits never wait for the full map search
+        if (drawPathAStar && mazeFieldEnabled && goalFieldDirty && (currentMode != 2))
+        {
+            UpdateDistanceField(&goalField, mazeGrid, sim.endCells, endCellsCount);
+            goalFieldDirty = false;
+        }
+
+        // Big mazes path query done: path replaced, edits done while searching applied to path graph
+        if (pathQuery.searching && IsMazeThreadDone(pathQueryThread))
+        {
+            UnloadMazeThread(pathQueryThread);
+            pathQueryThread = NULL;
+            pathQuery.searching = false;
+
+            if (pathQuery.editsLost)
+            {
+                UnloadPathGraph(mazePathGraph);
+                mazePathGraph = LoadPathGraph(mazeGrid, MAZE_CLUSTER_SIZE);
+            }
+            else for (int i = 0; i < pathQuery.editCount; i++) UpdatePathGraphCell(&mazePathGraph, mazeGrid, pathQuery.edits[i]);
+
+            pathQuery.editCount = 0;
+            pathQuery.editsLost = false;
+
+            if (pathQuery.target == 0)
+            {
+                free(editorPath);
+                editorPath = pathQuery.path;
+                pathPointCount = pathQuery.pointCount;
+                pathExpandedCount = pathQuery.expandedCount;
+                pathSearchTime = pathQuery.searchTime;
+                editorPathMode = 3;
+            }
+            else
+            {
+                free(gamePath);
+                gamePath = pathQuery.path;
+                gamePathPointCount = pathQuery.pointCount;
+                gamePathPlayerIndex = gamePathPointCount - 1;
+            }
+
+            pathQuery.path = NULL;
+        }
+
+        // Big mazes game path followed from player point, player out of path searches it again (old path drawn meanwhile)
+        if (drawPathAStar && !mazeFieldEnabled && (currentMode != 2) && (gamePathPointCount > 0) && !gamePathDirty)
+        {
+            int index = GetPathPointIndex(gamePath, gamePathPointCount, sim.playerCell, gamePathPlayerIndex, GAME_PATH_FOLLOW_RANGE);
+
+            if (index >= 0) gamePathPlayerIndex = index;
+            else if (!pathQuery.searching) gamePathDirty = true;
+        }
+
+        // Big mazes have no distance field: editor path and game path (from player cell) searched by path query worker
+        // NOTE: Editor path searched once painting ends, new maze not loaded while searching
+        if (drawPathAStar && !mazeFieldEnabled && !pathQuery.searching && !mazeBuilding)
+        {
+            if ((currentMode == 2) && editorPathDirty && !editorPainting)
+            {
+                pathQueryThread = StartPathQuery(&pathQuery, &mazePathGraph, mazeGrid, sim.startCells[0], sim.endCells[3], 0);
+                editorPathDirty = false;
+            }
+            else if ((currentMode != 2) && gamePathDirty)
+            {
+                pathQueryThread = StartPathQuery(&pathQuery, &mazePathGraph, mazeGrid, sim.playerCell, sim.endCells[3], 1);
+                gamePathDirty = false;
+            }
+        }
+
         // DONE: [1p] Multiple maze biomes supported
         // Implement changing between the different textures to be used as biomes
         // NOTE: For the 3d model, the current selected texture must be applied to the model material 
         if (IsKeyPressed(KEY_ONE))
         {
             currentBiome = 0;
-            mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            mdlMaze.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            SetMazeLayerTileset(&mazeLayer, texBiomes[currentBiome]);
         }
         else if (IsKeyPressed(KEY_TWO))
         {
             currentBiome = 1;
-            mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            mdlMaze.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            SetMazeLayerTileset(&mazeLayer, texBiomes[currentBiome]);
         }
         else if (IsKeyPressed(KEY_THREE))
         {
             currentBiome = 2;
-            mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            mdlMaze.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            SetMazeLayerTileset(&mazeLayer, texBiomes[currentBiome]);
         }
         else if (IsKeyPressed(KEY_FOUR))
         {
             currentBiome = 3;
-            mdlMaze.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            mdlMaze.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texBiomes[currentBiome];
+            SetMazeLayerTileset(&mazeLayer, texBiomes[currentBiome]);
         }
+
+        // Camera view in world coordinates, only visible 2d maze chunks are drawn
+        Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0, 0 }, camera2d);
+        Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera2d);
+        Rectangle view2d = { viewMin.x, viewMin.y, viewMax.x - viewMin.x, viewMax.y - viewMin.y };
+
+        // Draw dirty 2d maze chunks into layer render textures, out of 2d mode
+        if (currentMode == 0) UpdateMazeLayer(&mazeLayer, mazeGrid, (Vector2){ mdlPosition.x, mdlPosition.y }, view2d);
         //----------------------------------------------------------------------------------
 
         // Draw
@@ -437,61 +968,58 @@ int main(void)
             BeginMode2D(camera2d);
 
             // Draw lines rectangle over texture, scaled and centered on screen 
-            DrawRectangleLines(GetScreenWidth() / 2 - texMaze.width * MAZE_DRAW_SCALE / 2, GetScreenHeight() / 2 - texMaze.height * MAZE_DRAW_SCALE / 2, MAZE_WIDTH * MAZE_DRAW_SCALE, MAZE_HEIGHT * MAZE_DRAW_SCALE, RED);
+            DrawRectangleLines(mdlPosition.x, mdlPosition.y, mazeGrid.width * MAZE_DRAW_SCALE, mazeGrid.height * MAZE_DRAW_SCALE, RED);
 
-            // DONE: Draw maze walls and floor using current texture biome 
-            for (int y = 0; y < imMaze.height; y++)
-            {
-                for (int x = 0; x < imMaze.width; x++)
-                {
-                    if (GetImageColor(imMaze, x, y).r == 255)
-                    {
-                        DrawTexturePro(texBiomes[currentBiome], (Rectangle) { 0, texBiomes[currentBiome].height / 2, texBiomes[currentBiome].width / 2, texBiomes[currentBiome].height / 2 },
-                            (Rectangle) {
-                            mdlPosition.x + x * MAZE_DRAW_SCALE, mdlPosition.y + y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE
-                        }, (Vector2) { 0, 0 }, 0.0f, WHITE);
-                    }
-                    else if (GetImageColor(imMaze, x, y).r == 0)
-                    {
-                        DrawTexturePro(texBiomes[currentBiome], (Rectangle) { texBiomes[currentBiome].width / 2, texBiomes[currentBiome].height / 2, texBiomes[currentBiome].width / 2, texBiomes[currentBiome].height / 2 },
-                            (Rectangle) {
-                            mdlPosition.x + x * MAZE_DRAW_SCALE, mdlPosition.y + y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE
-                        }, (Vector2) { 0, 0 }, 0.0f, WHITE);
-                    }
-                }
-            }
+            // DONE: Draw maze walls and floor using current texture biome
+            // NOTE: Tiles are cached on layer chunks, one draw call per visible chunk
+            DrawMazeLayer(mazeLayer, (Vector2){ mdlPosition.x, mdlPosition.y }, view2d);
+
+            // Only items and path cells visible by camera are drawn, big mazes do not fit on screen
+            Point viewMinCell = { 0 };
+            Point viewMaxCell = { 0 };
+            GetMazeViewCells(camera2d, (Vector2){ mdlPosition.x, mdlPosition.y }, mazeGrid, &viewMinCell, &viewMaxCell);
 
             // DONE: Draw point A and B 
             for (int i = 0; i < endCellsCount; i++)
             {
-                DrawRectangle(mdlPosition.x + startCells[i].x * MAZE_DRAW_SCALE, mdlPosition.y + startCells[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, BLUE);
-                DrawRectangle(mdlPosition.x + endCells[i].x * MAZE_DRAW_SCALE, mdlPosition.y + endCells[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, RED);
+                DrawRectangle(mdlPosition.x + sim.startCells[i].x * MAZE_DRAW_SCALE, mdlPosition.y + sim.startCells[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, BLUE);
+                DrawRectangle(mdlPosition.x + sim.endCells[i].x * MAZE_DRAW_SCALE, mdlPosition.y + sim.endCells[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, RED);
             }
 
             // DONE: Draw player rectangle or sprite at player position
-            DrawRectangle(mdlPosition.x + playerCell.x * MAZE_DRAW_SCALE, mdlPosition.y + playerCell.y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, GREEN);
-            DrawRectangleLines(mdlPosition.x + playerCell.x * MAZE_DRAW_SCALE, mdlPosition.y + playerCell.y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, DARKGREEN);
+            // NOTE: Player drawn at interpolated position between simulation steps
+            DrawRectangleRec((Rectangle){ playerPosition.x, playerPosition.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE }, GREEN);
+            DrawRectangleLinesEx((Rectangle){ playerPosition.x, playerPosition.y, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE }, 1.0f, DARKGREEN);
 
             // DONE: Draw maze items 2d (using sprite texture?)
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++)
+            // NOTE: Items store only keeps live items, collected items are removed
+            DrawCollectibleItems2D(sim.items, (Vector2){ mdlPosition.x, mdlPosition.y }, viewMinCell, viewMaxCell);
+
+            // DONE: EXTRA: Draw pathfinding result, shorter path from start to end
+            if (drawPathAStar && mazeFieldEnabled)
             {
-                if (!collectibleItems[i].collected)
+                // Walk distance field from player cell, avoid drawing the player position and the end cell
+                Point pathCell = GetDistanceFieldNextCell(goalField, sim.playerCell);
+
+                while (GetDistanceFieldValue(goalField, pathCell) > 0)
                 {
-                    DrawRectangle(mdlPosition.x + collectibleItems[i].position.x * MAZE_DRAW_SCALE, mdlPosition.y + collectibleItems[i].position.y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, collectibleItems[i].color);
+                    if ((pathCell.x >= viewMinCell.x) && (pathCell.x <= viewMaxCell.x) && (pathCell.y >= viewMinCell.y) && (pathCell.y <= viewMaxCell.y))
+                    {
+                        DrawRectangle(mdlPosition.x + pathCell.x * MAZE_DRAW_SCALE, mdlPosition.y + pathCell.y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, YELLOW);
+                    }
+
+                    pathCell = GetDistanceFieldNextCell(goalField, pathCell);
                 }
             }
-
-            // DONE: EXTRA: Draw pathfinding result, shorter path from start to end
-            if (drawPathAStar)
+            else if (drawPathAStar)
             {
-                int pointCount = 0;
-                Point* path = LoadPathAStar(imMaze, playerCell, endCells[0], &pointCount);
-
-                for (int i = 1; i < pointCount - 1; i++) // i =1 to avoid drawing the player position and pointCount-1 to avoid drawing the end cell
+                // Big mazes path searched from player cell, avoid drawing the player and end cells
+                for (int i = 1; i < gamePathPlayerIndex; i++)
                 {
-                    DrawRectangle(mdlPosition.x + path[i].x * MAZE_DRAW_SCALE, mdlPosition.y + path[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, YELLOW);
+                    if ((gamePath[i].x < viewMinCell.x) || (gamePath[i].x > viewMaxCell.x) || (gamePath[i].y < viewMinCell.y) || (gamePath[i].y > viewMaxCell.y)) continue;
+
+                    DrawRectangle(mdlPosition.x + gamePath[i].x * MAZE_DRAW_SCALE, mdlPosition.y + gamePath[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, YELLOW);
                 }
-                free(path);
             }
 
             EndMode2D();
@@ -507,8 +1035,8 @@ int main(void)
 
             // Game info
             GuiGroupBox((Rectangle) { 10, 10, 200, 60 }, "Game Info");
-            GuiLabel((Rectangle) { 20, 20, 200, 20 }, TextFormat("Score: %d", playerScore));
-            GuiLabel((Rectangle) { 20, 40, 200, 20 }, TextFormat("Time Remaining: %02d:%02d", remainingTime / 60000, (remainingTime % 60000) / 1000));
+            GuiLabel((Rectangle) { 20, 20, 200, 20 }, TextFormat("Score: %d", sim.score));
+            GuiLabel((Rectangle) { 20, 40, 200, 20 }, TextFormat("Time Remaining: %02d:%02d", (int)sim.remainingTime / 60, (int)sim.remainingTime % 60));
 
             // Editor info
             GuiGroupBox((Rectangle) { 10, 80, 250, 340 }, "Map Configuration");
@@ -537,25 +1065,18 @@ int main(void)
                 mapRandomSeed = GetRandomValue(0, 100000);
             }
 
+            // Maze size, applied on regenerate
+            if (GuiValueBox((Rectangle) { 65, 360, 55, 20 }, "Width ", &mapWidth, MAZE_MIN_SIZE, MAZE_GRID_MAX_SIZE, mapWidthEditMode)) mapWidthEditMode = !mapWidthEditMode;
+            if (GuiValueBox((Rectangle) { 165, 360, 55, 20 }, "Height ", &mapHeight, MAZE_MIN_SIZE, MAZE_GRID_MAX_SIZE, mapHeightEditMode)) mapHeightEditMode = !mapHeightEditMode;
+
             // Regenerate maze button (moved down)
-            if (GuiButton((Rectangle) { 20, 360, 200, 50 }, "Regenerate Maze"))
+            // NOTE: Maze is built on a worker thread, build progress shown until new maze is ready
+            if (mazeBuilding)
             {
-                imMaze = GenImageMaze(MAZE_WIDTH, MAZE_HEIGHT, mapRowSpacing, mapColumnSpacing, mapPointsSkipChance);
-                UpdateTexture(texMaze, imMaze.data);
-                UnloadImageColors(mapPixels);
-                mapPixels = LoadImageColors(imMaze);
-
-                //Update 3d model
-                UnloadMesh(meshMaze);
-                meshMaze = GenMeshCubicmap(imMaze, (Vector3) { 1.0f, 1.0f, 1.0f });
-
-                //restart game
-                remainingTime = TIME_LIMIT_SECONDS;
-                playerCell = startCells[0];
-
-                // Set collectible items
-                SetCollectibleItems(imMaze, startCells, endCells, collectibleItems);
+                float buildProgress = mazeBuild.progress / 100.0f;
+                GuiProgressBar((Rectangle) { 20, 390, 200, 20 }, NULL, TextFormat("%i%%", mazeBuild.progress), &buildProgress, 0.0f, 1.0f);
             }
+            else if (GuiButton((Rectangle) { 20, 390, 200, 20 }, "Regenerate Maze")) mapRegenerate = true;
 
             // Audio control
             GuiGroupBox((Rectangle) { 10, 430, 250, 100 }, "Audio Control");
@@ -589,56 +1110,87 @@ int main(void)
         } break;
         case 1:     // Game 3D mode
         {
-            // Draw maze using cameraFP
-            BeginMode3D(cameraFP);
+            // Draw maze using player first-person camera, interpolated between simulation steps
+            Camera renderCamera = sim.camera;
+            renderCamera.position = (Vector3){
+                prevCamera.position.x + (sim.camera.position.x - prevCamera.position.x) * stepBlend,
+                prevCamera.position.y + (sim.camera.position.y - prevCamera.position.y) * stepBlend,
+                prevCamera.position.z + (sim.camera.position.z - prevCamera.position.z) * stepBlend };
+            renderCamera.target = (Vector3){
+                prevCamera.target.x + (sim.camera.target.x - prevCamera.target.x) * stepBlend,
+                prevCamera.target.y + (sim.camera.target.y - prevCamera.target.y) * stepBlend,
+                prevCamera.target.z + (sim.camera.target.z - prevCamera.target.z) * stepBlend };
+
+            // Potentially visible cells: rays across maze grid over camera horizontal field of view, one ray every 2 screen pixels
+            // NOTE: Frustum corners spread wider when looking up or down, full turn once frustum reaches vertical
+            Vector3 viewDirection = { renderCamera.target.x - renderCamera.position.x, renderCamera.target.y - renderCamera.position.y, renderCamera.target.z - renderCamera.position.z };
+            float viewPitch = fabsf(atan2f(viewDirection.y, sqrtf(viewDirection.x*viewDirection.x + viewDirection.z*viewDirection.z)));
+            float halfFovY = renderCamera.fovy*DEG2RAD/2.0f;
+            float viewForward = cosf(viewPitch + halfFovY)/cosf(halfFovY);
+            float fovX = (viewForward > 0.0f)? 2.0f*atanf(tanf(halfFovY)*GetScreenWidth()/GetScreenHeight()/viewForward) + MAZE_VIEW_FOV_MARGIN*DEG2RAD : 2.0f*PI;
+
+            UpdateMazeVisibility(&mazeVisibility, mazeGrid, (Vector2){ mdlPosition.x, mdlPosition.z }, (Vector2){ renderCamera.position.x, renderCamera.position.z },
+                (Vector2){ viewDirection.x, viewDirection.z }, (fovX < 2.0f*PI)? fovX : 2.0f*PI, GetScreenWidth()/2);
+
+            // Generate and upload visible 3d model chunks not loaded or edited since drawn
+            UpdateMazeModel(&mdlMaze, mazeGrid, mazeVisibility.chunks, mazeVisibility.chunkCount);
+
+            BeginMode3D(renderCamera);
 
             // DONE: Draw maze generated 3d model
-            DrawModel(mdlMaze, mdlPosition, 1.0f, WHITE);                     // Draw maze map
+            // NOTE: Only chunks with potentially visible cells drawn, draw cost follows player view instead of maze size
+            DrawMazeModelChunks(mdlMaze, mdlPosition, mazeVisibility.chunks, mazeVisibility.chunkCount);    // Draw maze map
 
             // EXTRA: Draw end cell as a cube
             for (int i = 0; i < endCellsCount; i++)
             {
-                DrawCube((Vector3) { mdlPosition.x + endCells[i].x, 40.3f, mdlPosition.z + endCells[i].y }, 1.0f, 1.0f, 1.0f, RED);
+                DrawCube((Vector3) { mdlPosition.x + sim.endCells[i].x, 40.3f, mdlPosition.z + sim.endCells[i].y }, 1.0f, 1.0f, 1.0f, RED);
             }
 
             // DONE: Maze items 3d draw (using 3d shape/model?) on required positions
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++)
-            {
-                if (!collectibleItems[i].collected)
-                {
-                    Color tintColor = collectibleItems[i].color;
-                    float rotationSpeed = 100.0f;
-                    float rotationAngle = GetTime() * rotationSpeed;
-
-                    DrawModelEx(collectable3D, (Vector3) { mdlPosition.x + collectibleItems[i].position.x, mdlPosition.y + 0.3f, mdlPosition.z + collectibleItems[i].position.y }, (Vector3) { 0, 1, 0 }, rotationAngle, (Vector3) { 0.1f, 0.1f, 0.1f }, tintColor);
-                }
-            }
+            DrawCollectibleItems3D(sim.items, &pickupBatch, mdlPosition, mazeVisibility);
 
             EndMode3D();
 
-            DrawTextureEx(texMaze, (Vector2) { GetScreenWidth() - texMaze.width * 4.0f - 20, 20.0f }, 0.0f, 4.0f, WHITE);
-            DrawRectangleLines(GetScreenWidth() - texMaze.width * 4 - 20, 20, texMaze.width * 4, texMaze.height * 4, GREEN);
+            DrawText(TextFormat("Loaded mesh: %i vertices, %i triangles (not merged: %i vertices, %i triangles)", mdlMaze.vertexCount, mdlMaze.triangleCount,
+                mdlMaze.cellVertexCount, mdlMaze.cellTriangleCount), 20, GetScreenHeight() - 40, 10, DARKGRAY);
+            DrawText(TextFormat("Visible: %i/%i chunks (%i loaded), %i cells", mazeVisibility.chunkCount, mdlMaze.chunksX * mdlMaze.chunksY, mdlMaze.loadedCount, mazeVisibility.cellCount),
+                20, GetScreenHeight() - 25, 10, DARKGRAY);
+
+            // Radar scaled to fit 256 pixels, up to 4 pixels per cell
+            float radarScale = 256.0f / ((mazeGrid.width > mazeGrid.height)? mazeGrid.width : mazeGrid.height);
+            if (radarScale > 4.0f) radarScale = 4.0f;
+            float radarMarkSize = (radarScale < 2.0f)? 2.0f : radarScale;  // Marks always visible on big mazes
+            Vector2 radarPosition = { GetScreenWidth() - texMaze.width * radarScale - 20, 20.0f };
+
+            DrawTextureEx(texMaze, radarPosition, 0.0f, radarScale, WHITE);
+            DrawRectangleLines(radarPosition.x, radarPosition.y, texMaze.width * radarScale, texMaze.height * radarScale, GREEN);
 
             // Draw player position radar
-            DrawRectangle(GetScreenWidth() - texMaze.width * 4 - 20 + playerCell.x * 4, 20 + playerCell.y * 4, 4, 4, RED);
+            DrawRectangleV((Vector2){ radarPosition.x + sim.playerCell.x * radarScale, radarPosition.y + sim.playerCell.y * radarScale }, (Vector2){ radarMarkSize, radarMarkSize }, RED);
 
             // Draw pathfinding in radar
-            if (drawPathAStar)
+            if (drawPathAStar && mazeFieldEnabled)
             {
-                int pointCount = 0;
-                Point* path = LoadPathAStar(imMaze, playerCell, endCells[0], &pointCount);
-                for (int i = 1; i < pointCount - 1; i++) // i =1 to avoid drawing the player position and pointCount-1 to avoid drawing the end cell
+                Point pathCell = GetDistanceFieldNextCell(goalField, sim.playerCell);
+
+                while (GetDistanceFieldValue(goalField, pathCell) > 0)
                 {
-                    DrawRectangle(GetScreenWidth() - texMaze.width * 4 - 20 + path[i].x * 4, 20 + path[i].y * 4, 4, 4, YELLOW);
+                    DrawRectangleV((Vector2){ radarPosition.x + pathCell.x * radarScale, radarPosition.y + pathCell.y * radarScale }, (Vector2){ radarMarkSize, radarMarkSize }, YELLOW);
+                    pathCell = GetDistanceFieldNextCell(goalField, pathCell);
+                }
+            }
+            else if (drawPathAStar)
+            {
+                for (int i = 1; i < gamePathPlayerIndex; i++)
+                {
+                    DrawRectangleV((Vector2){ radarPosition.x + gamePath[i].x * radarScale, radarPosition.y + gamePath[i].y * radarScale }, (Vector2){ radarMarkSize, radarMarkSize }, YELLOW);
                 }
-                free(path);
             }
 
             // Draw Maze items radar
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++) {
-                if (!collectibleItems[i].collected) {
-                    DrawRectangle(GetScreenWidth() - texMaze.width * 4 - 20 + collectibleItems[i].position.x * 4, 20 + collectibleItems[i].position.y * 4, 4, 4, collectibleItems[i].color);
-                }
+            for (int i = 0; i < sim.items.count; i++) {
+                DrawRectangleV((Vector2){ radarPosition.x + sim.items.items[i].position.x * radarScale, radarPosition.y + sim.items.items[i].position.y * radarScale }, (Vector2){ radarMarkSize, radarMarkSize }, sim.items.items[i].color);
             }
 
             // GUI
@@ -648,8 +1200,8 @@ int main(void)
 
             // Game info
             GuiGroupBox((Rectangle) { 10, 10, 200, 60 }, "Game Info");
-            GuiLabel((Rectangle) { 20, 20, 200, 20 }, TextFormat("Score: %d", playerScore));
-            GuiLabel((Rectangle) { 20, 40, 200, 20 }, TextFormat("Time Remaining: %02d:%02d", remainingTime / 60000, (remainingTime % 60000) / 1000));
+            GuiLabel((Rectangle) { 20, 20, 200, 20 }, TextFormat("Score: %d", sim.score));
+            GuiLabel((Rectangle) { 20, 40, 200, 20 }, TextFormat("Time Remaining: %02d:%02d", (int)sim.remainingTime / 60, (int)sim.remainingTime % 60));
 
             // Controls info
             GuiGroupBox((Rectangle) { 10, 80, 250, 140 }, "Controls");
@@ -663,30 +1215,57 @@ int main(void)
         } break;
         case 2:     // Editor mode
         {
+            BeginMode2D(cameraEditor);
+
             // Draw maze
-            DrawTextureEx(texMaze, (Vector2) { GetScreenWidth() / 2 - texMaze.width * MAZE_DRAW_SCALE / 2, GetScreenHeight() / 2 - texMaze.height * MAZE_DRAW_SCALE / 2 }, 0.0f, MAZE_DRAW_SCALE, WHITE);
-            DrawRectangleLines(GetScreenWidth() / 2 - texMaze.width * MAZE_DRAW_SCALE / 2, GetScreenHeight() / 2 - texMaze.height * MAZE_DRAW_SCALE / 2, MAZE_WIDTH * MAZE_DRAW_SCALE, MAZE_HEIGHT * MAZE_DRAW_SCALE, RED);
+            DrawTextureEx(texMaze, (Vector2) { mdlPosition.x, mdlPosition.y }, 0.0f, MAZE_DRAW_SCALE, WHITE);
+            DrawRectangleLines(mdlPosition.x, mdlPosition.y, mazeGrid.width * MAZE_DRAW_SCALE, mazeGrid.height * MAZE_DRAW_SCALE, RED);
 
             // DONE: Draw maze items 2d (using sprite texture?)
-            for (int i = 0; i < MAX_MAZE_ITEMS; i++) {
-                if (!collectibleItems[i].collected) {
-                    DrawRectangle(mdlPosition.x + collectibleItems[i].position.x * MAZE_DRAW_SCALE, mdlPosition.y + collectibleItems[i].position.y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, collectibleItems[i].color);
-                }
-            }
+            Point viewMinCell = { 0 };
+            Point viewMaxCell = { 0 };
+            GetMazeViewCells(cameraEditor, (Vector2){ mdlPosition.x, mdlPosition.y }, mazeGrid, &viewMinCell, &viewMaxCell);
+            DrawCollectibleItems2D(sim.items, (Vector2){ mdlPosition.x, mdlPosition.y }, viewMinCell, viewMaxCell);
 
             // Draw pathfinding result, shorter path from start to end
-            if (drawPathAStar)
+            // NOTE: Path is searched on update, only when map or search mode changed
+            if (drawPathAStar && (editorPath != NULL))
             {
-                int pointCount = 0;
-                Point* path = LoadPathAStar(imMaze, startCells[0], endCells[3], &pointCount);
-                for (int i = 0; i < pointCount; i++)
+                for (int i = 0; i < pathPointCount; i++)
                 {
-                    DrawRectangle(mdlPosition.x + path[i].x * MAZE_DRAW_SCALE, mdlPosition.y + path[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, YELLOW);
+                    if ((editorPath[i].x < viewMinCell.x) || (editorPath[i].x > viewMaxCell.x) || (editorPath[i].y < viewMinCell.y) || (editorPath[i].y > viewMaxCell.y)) continue;
+
+                    DrawRectangle(mdlPosition.x + editorPath[i].x * MAZE_DRAW_SCALE, mdlPosition.y + editorPath[i].y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, YELLOW);
                 }
-                free(path);
             }
 
+            EndMode2D();
+
             //GUI
+            // Path search selection
+            GuiGroupBox((Rectangle) { 10, 10, 250, 60 }, "Path Search");
+            GuiToggleGroup((Rectangle) { 20, 20, 56, 20 }, "D* LITE;A*;JPS;HPA*", &pathSearchMode);
+            if (pathSearchMode == 0) GuiLabel((Rectangle) { 20, 45, 230, 20 }, TextFormat("Points: %d - Time: %.3f ms", pathPointCount, pathSearchTime * 1000.0));
+            else if (pathQuery.searching || (!mazeFieldEnabled && editorPathDirty)) GuiLabel((Rectangle) { 20, 45, 230, 20 }, TextFormat("Points: %d - Searching...", pathPointCount));
+            else GuiLabel((Rectangle) { 20, 45, 230, 20 }, TextFormat("Points: %d - Expanded: %d - Time: %.3f ms", pathPointCount, pathExpandedCount, pathSearchTime * 1000.0));
+
+            // Editor view controls
+            GuiLabel((Rectangle) { GetScreenWidth() - 210, 10, 200, 20 }, "AWSD - Pan view, Wheel - Zoom view");
+
+            // Maze regions info, end cells must be reachable from start cell
+            if (mazeFieldEnabled)
+            {
+                GuiGroupBox((Rectangle) { GetScreenWidth() - 260, 40, 250, 80 }, "Map Regions");
+                GuiLabel((Rectangle) { GetScreenWidth() - 250, 50, 230, 20 }, TextFormat("Regions: %d - Last edit: %.3f ms", mazeRegions.regionCount, regionsTime * 1000.0));
+
+                if (mazeConnected) GuiLabel((Rectangle) { GetScreenWidth() - 250, 70, 230, 20 }, TextFormat("End cells reachable - Repaired: %d walls", repairWallCount));
+                else
+                {
+                    GuiLabel((Rectangle) { GetScreenWidth() - 250, 70, 230, 20 }, "End cells NOT reachable from start");
+                    if (GuiButton((Rectangle) { GetScreenWidth() - 250, 92, 230, 20 }, "Repair Maze (remove min walls)")) mapRepair = true;
+                }
+            }
+
             // Editor info
             GuiGroupBox((Rectangle) { 10, 80, 250, 340 }, "Map Configuration");
             GuiLabel((Rectangle) { 20, 90, 200, 20 }, "Row Spacing");
@@ -716,25 +1295,18 @@ int main(void)
                 mapRandomSeed = GetRandomValue(0, 100000);
             }
 
+            // Maze size, applied on regenerate
+            if (GuiValueBox((Rectangle) { 65, 360, 55, 20 }, "Width ", &mapWidth, MAZE_MIN_SIZE, MAZE_GRID_MAX_SIZE, mapWidthEditMode)) mapWidthEditMode = !mapWidthEditMode;
+            if (GuiValueBox((Rectangle) { 165, 360, 55, 20 }, "Height ", &mapHeight, MAZE_MIN_SIZE, MAZE_GRID_MAX_SIZE, mapHeightEditMode)) mapHeightEditMode = !mapHeightEditMode;
+
             // Regenerate maze button (moved down)
-            if (GuiButton((Rectangle) { 20, 360, 200, 50 }, "Regenerate Maze"))
+            // NOTE: Maze is built on a worker thread, build progress shown until new maze is ready
+            if (mazeBuilding)
             {
-                imMaze = GenImageMaze(MAZE_WIDTH, MAZE_HEIGHT, mapRowSpacing, mapColumnSpacing, mapPointsSkipChance);
-                UpdateTexture(texMaze, imMaze.data);
-                UnloadImageColors(mapPixels);
-                mapPixels = LoadImageColors(imMaze);
-
-                // Update 3d model
-                UnloadMesh(meshMaze);
-                meshMaze = GenMeshCubicmap(imMaze, (Vector3) { 1.0f, 1.0f, 1.0f });
-
-                // Restart game
-                remainingTime = TIME_LIMIT_SECONDS;
-                playerCell = startCells[0];
-
-                // Set collectible items
-                SetCollectibleItems(imMaze, startCells, endCells, collectibleItems);
+                float buildProgress = mazeBuild.progress / 100.0f;
+                GuiProgressBar((Rectangle) { 20, 390, 200, 20 }, NULL, TextFormat("%i%%", mazeBuild.progress), &buildProgress, 0.0f, 1.0f);
             }
+            else if (GuiButton((Rectangle) { 20, 390, 200, 20 }, "Regenerate Maze")) mapRegenerate = true;
 
             // Audio control
             GuiGroupBox((Rectangle) { 10, 430, 250, 100 }, "Audio Control");
@@ -779,10 +1351,34 @@ int main(void)
         //--------------------------------------------------------------------------------------
         // 
         // DONE: Unload all other resources (textures, sprites, music, sound...)
+        if (mazeBuilding)
+        {
+            UnloadMazeThread(mazeBuildThread);     // Wait for maze build, results not used
+            UnloadMazeBuild(mazeBuild);
+        }
+
+        UnloadMazeThread(pathQueryThread);         // Wait for path query, results not used
+        free(pathQuery.path);
+        free(pathQuery.edits);
+        UnloadMazeGrid(pathQuery.grid);
+
         UnloadTexture(texMaze);     // Unload maze texture from VRAM (GPU)
         UnloadImage(imMaze);        // Unload maze image from RAM (CPU)
+        UnloadPickupBatch(pickupBatch);
         UnloadModel(collectable3D);
-        UnloadImageColors(mapPixels);
+        UnloadMazeSim(sim);
+        UnloadMazeGrid(mazeGrid);
+        UnloadDistanceField(goalField);
+        UnloadPathPlanner(editorPathPlanner);
+        UnloadPathGraph(mazePathGraph);
+        UnloadPathAStarData();
+        UnloadMazeRegions(mazeRegions);
+        UnloadMazeGrid(itemsGrid);
+        UnloadMazeLayer(mazeLayer);
+        UnloadMazeModel(mdlMaze);
+        UnloadMazeVisibility(mazeVisibility);
+        free(editorPath);
+        free(gamePath);
 
         for (int i = 0; i < texBiomesCount; i++)     
         {
@@ -801,331 +1397,353 @@ int main(void)
         return 0;
 }
 
-// Generate procedural maze image, using grid-based algorithm
-// NOTE: Black=Walkable cell, White=Wall/Block cell
-static Image GenImageMaze(int width, int height, int spacingRows, int spacingCols, float skipChance)
+static MazeSimInput GetMazeSimInput(int mode, float deltaTime)
 {
-    // Generate image of plain color (BLACK)
-    Image imMaze = GenImageColor(width, height, BLACK);
-
-    // Allocate an array of point used for maze generation
-    // NOTE: Dynamic array allocation, memory allocated in HEAP (MAX: Available RAM)
-    Point* mazePoints = (Point*)malloc(MAZE_WIDTH * MAZE_HEIGHT * sizeof(Point));
-    int mazePointsCounter = 0;
+    MazeSimInput input = { 0 };
 
-    // Start traversing image data, line by line, to paint our maze
-    for (int y = 0; y < imMaze.height; y++)
+    if (mode == 0)
     {
-        for (int x = 0; x < imMaze.width; x++)
-        {
-            // Check image borders (1 px)
-            if ((x == 0) || (x == (imMaze.width - 1)) || (y == 0) || (y == (imMaze.height - 1)))
-            {
-                ImageDrawPixel(&imMaze, x, y, WHITE);   // Image border pixels set to WHITE
-            }
-            else
-            {
-                // Check pixel module to set maze corridors width and height
-                if ((x % spacingRows == 0) && (y % spacingCols == 0))
-                {
-                    // Get change to define a point for further processing
-                    float chance = (float)GetRandomValue(0, 100) / 100.0f;
+        // Cursors || WASD, one cell per update while key is down
+        if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) input.move.y -= 1;
+        if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) input.move.y += 1;
+        if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) input.move.x -= 1;
+        if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) input.move.x += 1;
+    }
+    else
+    {
+        // WASD walk, cursors view rotation, same controls as UpdateCamera(CAMERA_FIRST_PERSON)
+        // NOTE: Mouse view rotation is added once per frame by caller, not per step
+        if (IsKeyDown(KEY_W)) input.walk.x += 1.0f;
+        if (IsKeyDown(KEY_S)) input.walk.x -= 1.0f;
+        if (IsKeyDown(KEY_D)) input.walk.y += 1.0f;
+        if (IsKeyDown(KEY_A)) input.walk.y -= 1.0f;
+
+        float rotation = 1.8f * RAD2DEG * deltaTime;
+        if (IsKeyDown(KEY_RIGHT)) input.look.x += rotation;
+        if (IsKeyDown(KEY_LEFT)) input.look.x -= rotation;
+        if (IsKeyDown(KEY_DOWN)) input.look.y += rotation;
+        if (IsKeyDown(KEY_UP)) input.look.y -= rotation;
+    }
 
-                    if (chance >= skipChance)
-                    {
-                        // Set point as wall...
-                        ImageDrawPixel(&imMaze, x, y, WHITE);
+    return input;
+}
 
-                        // ...save point for further processing
-                        mazePoints[mazePointsCounter] = (Point){ x, y };
-                        mazePointsCounter++;
-                    }
-                }
-            }
-        }
+// Update maze regions after map changes, items grid set to cells reachable from start cell
+static bool UpdateMazeReachability(MazeRegions* regions, MazeGrid* itemsGrid, MazeGrid mazeGrid, Point startCell, const Point* endCells)
+{
+    UpdateMazeRegions(regions, mazeGrid);
+
+    // Items grid reloaded if maze size changed
+    if ((itemsGrid->width != mazeGrid.width) || (itemsGrid->height != mazeGrid.height))
+    {
+        UnloadMazeGrid(*itemsGrid);
+        *itemsGrid = LoadMazeGrid(mazeGrid.width, mazeGrid.height);
     }
 
-    // Define an array of 4 directions for convenience
-    Point directions[4] = {
-        { 0, -1 },      // Up
-        { 0, 1 },       // Down
-        { -1, 0 },      // Left
-        { 1, 0 },       // Right
-    };
-
-    // Load a random sequence of points, to be used as indices, so,
-    // we can access mazePoints[] randomly indexed, instead of following the order we gor them
-    int* pointIndices = LoadRandomSequence(mazePointsCounter, 0, mazePointsCounter - 1);
-
-    // Process every random maze point, moving in one random direction,
-    // until we collision with another wall (WHITE pixel)
-    for (int i = 0; i < mazePointsCounter; i++)
+    SetMazeGridRegion(itemsGrid, *regions, GetMazeRegion(*regions, startCell));
+
+    for (int i = 0; i < 4; i++)
     {
-        Point currentPoint = mazePoints[pointIndices[i]];
-        Point currentDir = directions[GetRandomValue(0, 3)];
-        currentPoint.x += currentDir.x;
-        currentPoint.y += currentDir.y;
-
-        // Keep incrementing wall in selected direction until a WHITE pixel is found
-        // NOTE: We only check against the color.r component
-        while (GetImageColor(imMaze, currentPoint.x, currentPoint.y).r != 255)
-        {
-            ImageDrawPixel(&imMaze, currentPoint.x, currentPoint.y, WHITE);
+        if (CheckMazeCellsConnected(*regions, startCell, endCells[i])) return true;
+    }
 
-            currentPoint.x += currentDir.x;
-            currentPoint.y += currentDir.y;
-        }
+    return false;
+}
+
+// Update maze regions after a single cell edit
+// NOTE: Start region changed only on edited cell if its size changed by one cell at most,
+// otherwise other regions joined it and the whole items grid is set again
+static bool UpdateMazeReachabilityCell(MazeRegions* regions, MazeGrid* itemsGrid, MazeGrid mazeGrid, Point startCell, const Point* endCells, Point cell, bool* relabel)
+{
+    int startRegion = GetMazeRegion(*regions, startCell);
+    int startSize = GetMazeRegionSize(*regions, startRegion);
+
+    if (!UpdateMazeRegionsCell(regions, mazeGrid, cell)) *relabel = true;
+
+    int region = GetMazeRegion(*regions, startCell);
+    int sizeChange = GetMazeRegionSize(*regions, region) - startSize;
+
+    if ((startRegion != -1) && (region != -1) && (sizeChange >= -1) && (sizeChange <= 1))
+    {
+        SetMazeGridCell(itemsGrid, cell.x, cell.y, (GetMazeRegion(*regions, cell) != region));
     }
+    else SetMazeGridRegion(itemsGrid, *regions, region);
 
-    UnloadRandomSequence(pointIndices);
+    for (int i = 0; i < 4; i++)
+    {
+        if (CheckMazeCellsConnected(*regions, startCell, endCells[i])) return true;
+    }
 
-    return imMaze;
+    return false;
 }
 
-
-static void SetCollectibleItems(Image imMaze, Point startCells[], Point endCells[], CollectibleItem collectibleItems[])
+// Build new maze data with build configuration
+// NOTE: Same steps as game initialization, progress updated after every step
+static int BuildMaze(void* data)
 {
-    for (int i = 0; i < MAX_MAZE_ITEMS; i++)
+    MazeBuild* build = (MazeBuild*)data;
+    double buildTime = GetTime();
+
+    // Tiles generated on all CPU cores but one, main thread keeps running the game
+    int threadCount = (GetMazeThreadCpuCount() > 1)? GetMazeThreadCpuCount() - 1 : 1;
+
+    build->grid = GenMazeGridTiled(build->width, build->height, build->spacingRows, build->spacingCols, build->skipChance, build->seed, threadCount);
+
+    if (build->grid.words == NULL)
     {
-        collectibleItems[i].position = (Point){ GetRandomValue(1, imMaze.width - 2), GetRandomValue(1, imMaze.height - 2) };
-        collectibleItems[i].collected = false;
-        collectibleItems[i].value = GetRandomValue(1, 3);
-
-        // Set color based on value
-        switch (collectibleItems[i].value) {
-        case 1: collectibleItems[i].color = ORANGE; break;
-        case 2: collectibleItems[i].color = RAYWHITE; break;
-        case 3: collectibleItems[i].color = PURPLE; break;
-        default: break;
-        }
+        build->fallback = true;
+        build->width = MAZE_WIDTH;
+        build->height = MAZE_HEIGHT;
+        build->grid = GenMazeGridTiled(build->width, build->height, build->spacingRows, build->spacingCols, build->skipChance, build->seed, threadCount);
+    }
 
-        // Check if collectible item is placed on start or end cells and if so, regenerate
-        for (int j = 0; j < 4; j++)
-        {
-            if ((collectibleItems[i].position.x == startCells[j].x && collectibleItems[i].position.y == startCells[j].y) ||
-                (collectibleItems[i].position.x == endCells[j].x && collectibleItems[i].position.y == endCells[j].y))
-            {
-                collectibleItems[i].position = (Point){ GetRandomValue(1, imMaze.width - 2), GetRandomValue(1, imMaze.height - 2) };
-                j = 0;
-            }
-        }
+    build->progress = 40;
+
+    MazeGrid grid = build->grid;
+    bool fieldEnabled = ((size_t)grid.width * grid.height <= MAZE_FIELD_MAX_CELLS);
+
+    build->image = LoadImageFromMazeGrid(grid);
+    build->origin = (Vector3){ build->screenSize.x / 2 - grid.width * MAZE_DRAW_SCALE / 2, build->screenSize.y / 2 - grid.height * MAZE_DRAW_SCALE / 2, 0.0f };
+    build->progress = 50;
+
+    // Game restarted on new maze, items placed only on cells reachable from start (supported sizes)
+    // NOTE: Regions labelled before game init, items are placed once
+    Point startCells[4] = { 0 };
+    Point endCells[4] = { 0 };
+    GetMazeSimCells(grid.width, grid.height, startCells, endCells);
+
+    build->connected = true;
+    if (fieldEnabled) build->connected = UpdateMazeReachability(&build->regions, &build->itemsGrid, grid, startCells[0], endCells);
+
+    build->sim = InitMazeSim(grid, build->itemsGrid, build->origin, build->seed, build->itemCount);
+
+    build->progress = 65;
+
+    // Search data for the new maze size, per-cell data only for supported sizes
+    if (fieldEnabled)
+    {
+        UpdateDistanceField(&build->goalField, grid, build->sim.endCells, sizeof(build->sim.endCells) / sizeof(Point));
+        build->planner = LoadPathPlanner(grid.width, grid.height);
+    }
+
+    build->pathGraph = LoadPathGraph(grid, MAZE_CLUSTER_SIZE);
+    build->progress = 80;
+
+    // 3d model chunk meshes, only uploaded by main thread
+    // NOTE: Only generated if all chunks can be loaded, bigger mazes generate visible chunks when drawn
+    int chunksX = (grid.width + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE;
+    int chunksY = (grid.height + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE;
+
+    if (chunksX * chunksY <= MAZE_MESH_MAX_CHUNKS)
+    {
+        build->chunkMeshes = (Mesh*)malloc(chunksX * chunksY * sizeof(Mesh));
 
-        // Check if collectible item is placed on a wall and if so, regenerate
-        while (GetImageColor(imMaze, collectibleItems[i].position.x, collectibleItems[i].position.y).r == 255)
+        for (int i = 0; i < chunksX * chunksY; i++)
         {
-            collectibleItems[i].position = (Point){ GetRandomValue(1, imMaze.width - 2), GetRandomValue(1, imMaze.height - 2) };
+            build->chunkMeshes[i] = GenMeshMazeChunk(grid, i % chunksX, i / chunksX);
+            build->progress = 80 + 20 * (i + 1) / (chunksX * chunksY);
         }
     }
-}
 
-// DONE: EXTRA: [10p] Get shorter path between two points, implements pathfinding algorithm: A*
-// NOTE: The functions returns an array of points and the pointCount
+    build->buildTime = GetTime() - buildTime;
+    build->progress = 100;
 
-typedef struct PathNode
-{
-    Point position;
-    int gValue;         // Cost from the start node to this node
-    int hValue;         // Heuristic estimate of the cost from this node to the end node
-    struct PathNode* parent;
-} PathNode;
+    return 0;
+}
 
-typedef struct OpenList
+// Load asset file data
+static int LoadAssetFile(void* data)
 {
-    PathNode* node;
-    struct OpenList* next; // Pointer to the next node in the list
-} OpenList;
+    AssetLoad* asset = (AssetLoad*)data;
+    double loadTime = GetTime();
 
-typedef struct ClosedList
-{
-    Point position;
-    struct ClosedList* next; // Pointer to the next node in the list
-} ClosedList;
+    if (asset->type == 0) asset->image = LoadImage(asset->fileName);
+    else asset->wave = LoadWave(asset->fileName);
 
-int ManhattanDistance(Point a, Point b)
-{
-    return abs(a.x - b.x) + abs(a.y - b.y);
+    asset->loadTime = GetTime() - loadTime;
+
+    return 0;
 }
 
-bool IsAccessible(Image map, Point p, ClosedList* closedList)
+// Search path query on path graph
+static int SearchPathQuery(void* data)
 {
-    // Check if the point is within bounds
-    if (p.x < 0 || p.y < 0 || p.x >= map.width || p.y >= map.height) return false;
+    PathQuery* query = (PathQuery*)data;
+    double searchTime = GetMazeThreadTime();
 
-    // Check if the point is walkable
-    if (GetImageColor(map, p.x, p.y).r != 0) return false;
+    query->path = LoadPathHPA(query->graph, query->grid, query->start, query->end, &query->pointCount);
+    query->expandedCount = GetPathSearchExpandedCount();
+    query->searchTime = GetMazeThreadTime() - searchTime;
 
-    // Check if the point is in the closed list
-    ClosedList* current = closedList;
+    return 0;
+}
 
-    while (current != NULL)
+// Start path query on a worker thread
+// NOTE: Grid copied on calling thread, map edits on main thread never touch worker data
+static MazeThread* StartPathQuery(PathQuery* query, PathGraph* graph, MazeGrid mazeGrid, Point start, Point end, int target)
+{
+    // Grid copy reloaded only if maze size changed
+    if ((query->grid.width != mazeGrid.width) || (query->grid.height != mazeGrid.height))
     {
-        if (current->position.x == p.x && current->position.y == p.y) return false;
-        current = current->next;
+        UnloadMazeGrid(query->grid);
+        query->grid = LoadMazeGrid(mazeGrid.width, mazeGrid.height);
     }
 
-    return true;
+    if (query->grid.words == NULL) return NULL;
+
+    memcpy(query->grid.words, mazeGrid.words, (size_t)mazeGrid.rowWords * mazeGrid.height * sizeof(uint64_t));
+
+    query->graph = graph;
+    query->start = start;
+    query->end = end;
+    query->target = target;
+    query->searching = true;
+
+    MazeThread* thread = LoadMazeThread(SearchPathQuery, query);
+    if (thread == NULL) SearchPathQuery(query);     // Thread could not be created, path searched on calling thread
+
+    return thread;
 }
 
-// Find the node with the lowest f value in the open list
-PathNode* FindLowestFInOpenList(OpenList* openList)
+// Notify a map cell edit to path graph
+static void UpdatePathQueryCell(PathQuery* query, PathGraph* graph, MazeGrid mazeGrid, Point cell)
 {
-    PathNode* lowestFNode = NULL;
-    int lowestF = INT_MAX;
-    OpenList* current = openList;
+    if (!query->searching)
+    {
+        UpdatePathGraphCell(graph, mazeGrid, cell);
+        return;
+    }
 
-    while (current != NULL)
+    if (query->editCount == query->editCapacity)
     {
-        if ((current->node->gValue + current->node->hValue) < lowestF)
+        int capacity = (query->editCapacity > 0)? 2 * query->editCapacity : 256;
+        Point* edits = (Point*)realloc(query->edits, capacity * sizeof(Point));
+
+        if (edits == NULL)
         {
-            lowestF = current->node->gValue + current->node->hValue;
-            lowestFNode = current->node;
+            query->editsLost = true;
+            return;
         }
-        current = current->next;
+
+        query->edits = edits;
+        query->editCapacity = capacity;
     }
-    return lowestFNode;
+
+    query->edits[query->editCount++] = cell;
 }
 
-// Remove a node from the open list
-void RemoveFromOpenList(OpenList** openList, PathNode* nodeToRemove)
+// Get index of cell in path, only points up to range away from index checked
+static int GetPathPointIndex(const Point* path, int pointCount, Point cell, int index, int range)
 {
-    OpenList* current = *openList;
-    OpenList* prev = NULL;
+    int minIndex = (index - range > 0)? index - range : 0;
+    int maxIndex = (index + range < pointCount - 1)? index + range : pointCount - 1;
 
-    while (current != NULL)
+    for (int i = minIndex; i <= maxIndex; i++)
     {
-        if (current->node == nodeToRemove)
-        {
-            if (prev == NULL) {
-                *openList = current->next;
-            }
-            else
-            {
-                prev->next = current->next;
-            }
-            free(current);
-            break;
-        }
-        prev = current;
-        current = current->next;
+        if ((path[i].x == cell.x) && (path[i].y == cell.y)) return i;
     }
+
+    return -1;
 }
 
-static Point* LoadPathAStar(Image map, Point start, Point end, int* pointCount) {
-    Point* path = NULL;
-    int pathCounter = 0;
-
-    // Initialize open and closed lists
-    OpenList* openList = NULL;
-    ClosedList* closedList = NULL;
-
-    // Create start node
-    PathNode* startNode = (PathNode*)malloc(sizeof(PathNode));
-    startNode->position = start;
-    startNode->gValue = 0;
-    startNode->hValue = ManhattanDistance(start, end);
-    startNode->parent = NULL;
-
-    // Add start node to open list
-    OpenList* startNodeItem = (OpenList*)malloc(sizeof(OpenList));
-    startNodeItem->node = startNode;
-    startNodeItem->next = NULL;
-    openList = startNodeItem;
-
-    // Loop until the open list is empty
-    while (openList != NULL)
+// Unload maze build results
+static void UnloadMazeBuild(MazeBuild build)
+{
+    UnloadMazeGrid(build.grid);
+    UnloadImage(build.image);
+    UnloadMazeSim(build.sim);
+    UnloadMazeRegions(build.regions);
+    UnloadMazeGrid(build.itemsGrid);
+    UnloadDistanceField(build.goalField);
+    UnloadPathPlanner(build.planner);
+    UnloadPathGraph(build.pathGraph);
+
+    if (build.chunkMeshes != NULL)
     {
-        // Find the node with the lowest f value in the open list
-        PathNode* currentNode = FindLowestFInOpenList(openList);
+        int chunkCount = ((build.grid.width + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE) * ((build.grid.height + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE);
 
-        //Remove current node from open list
-        RemoveFromOpenList(&openList, currentNode);
+        for (int i = 0; i < chunkCount; i++) UnloadMesh(build.chunkMeshes[i]);
+        free(build.chunkMeshes);
+    }
+}
 
-        // Add current node to closed list
-        ClosedList* newClosedListNode = (ClosedList*)malloc(sizeof(ClosedList));
-        newClosedListNode->position = currentNode->position;
-        newClosedListNode->next = closedList;
-        closedList = newClosedListNode;
+// Get maze cells visible by 2d camera, view corners from camera target, offset and zoom
+static void GetMazeViewCells(Camera2D camera, Vector2 position, MazeGrid mazeGrid, Point* min, Point* max)
+{
+    Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0, 0 }, camera);
+    Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+
+    // NOTE: floorf() required, view could start left or above the maze
+    min->x = (int)floorf((viewMin.x - position.x) / MAZE_DRAW_SCALE);
+    min->y = (int)floorf((viewMin.y - position.y) / MAZE_DRAW_SCALE);
+    max->x = (int)floorf((viewMax.x - position.x) / MAZE_DRAW_SCALE);
+    max->y = (int)floorf((viewMax.y - position.y) / MAZE_DRAW_SCALE);
+
+    if (min->x < 0) min->x = 0;
+    if (min->y < 0) min->y = 0;
+    if (max->x > mazeGrid.width - 1) max->x = mazeGrid.width - 1;
+    if (max->y > mazeGrid.height - 1) max->y = mazeGrid.height - 1;
+}
 
-        // Check if the current node is the end node
-        if (currentNode->position.x == end.x && currentNode->position.y == end.y)
+// Draw collectible items on visible cells
+static void DrawCollectibleItems2D(ItemStore items, Vector2 position, Point viewMin, Point viewMax)
+{
+    if ((viewMin.x > viewMax.x) || (viewMin.y > viewMax.y)) return;
+
+    long long viewCellCount = (long long)(viewMax.x - viewMin.x + 1) * (viewMax.y - viewMin.y + 1);
+
+    if (viewCellCount < items.count)
+    {
+        // Many items (or zoomed in), visible cells searched on items cell index
+        for (int y = viewMin.y; y <= viewMax.y; y++)
         {
-            PathNode* currenbNode = currentNode;
-            while (currenbNode != NULL)
+            for (int x = viewMin.x; x <= viewMax.x; x++)
             {
-                pathCounter++;
-                path = (Point*)realloc(path, pathCounter * sizeof(Point));
-                path[pathCounter - 1] = currenbNode->position;
-                currenbNode = currenbNode->parent;
+                int item = GetCollectibleItemIndex(items, (Point){ x, y });
+
+                if (item != -1) DrawRectangle(position.x + x * MAZE_DRAW_SCALE, position.y + y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, items.items[item].color);
             }
-            break;
         }
-
-        //Generate Successors of current Node
-        for (int dx = -1; dx <= 1; dx++)
+    }
+    else
+    {
+        for (int i = 0; i < items.count; i++)
         {
-            for (int dy = -1; dy <= 1; dy++)
-            {
-                if ((dx == 0 && dy == 0) || (dx != 0 && dy != 0))
-                {
-                    continue;
-                }
+            Point cell = items.items[i].position;
 
-                // Create successor node and check if it is accessible
-                Point successorPosition = { currentNode->position.x + dx, currentNode->position.y + dy };
-                if (!IsAccessible(map, successorPosition, closedList))
-                {
-                    continue;
-                }
-
-                // Calculate tentative g value for the successor node
-                int tentatinveG = currentNode->gValue + 1;
-                bool found = false;
-                OpenList* openListPtr = openList;
-
-                // Check if the successor node is in the open list
-                while (openListPtr != NULL)
-                {
-                    if (openListPtr->node->position.x == successorPosition.x && openListPtr->node->position.y == successorPosition.y)
-                    {
-                        found = true; // Successor node is in the open list
-                        break;
-                    }
-                    openListPtr = openListPtr->next;
-                }
+            if ((cell.x < viewMin.x) || (cell.x > viewMax.x) || (cell.y < viewMin.y) || (cell.y > viewMax.y)) continue;
 
-                if (!found) // Successor node is not in the open list
-                {
-                    // Add successor node to open list
-                    PathNode* successorNode = (PathNode*)malloc(sizeof(PathNode));
-                    successorNode->position = successorPosition;
-                    successorNode->gValue = tentatinveG;
-                    successorNode->hValue = ManhattanDistance(successorPosition, end);
-                    successorNode->parent = currentNode;
-                    OpenList* newSuccessorNodeOpenList = (OpenList*)malloc(sizeof(OpenList));
-                    newSuccessorNodeOpenList->node = successorNode;
-                    newSuccessorNodeOpenList->next = openList;
-                    openList = newSuccessorNodeOpenList;
-                }
-            }
+            DrawRectangle(position.x + cell.x * MAZE_DRAW_SCALE, position.y + cell.y * MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, MAZE_DRAW_SCALE, items.items[i].color);
         }
     }
+}
 
-    // Free memory
-    while (openList != NULL)
-    {
-        OpenList* temp = openList;
-        openList = openList->next;
-        free(temp);
-    }
+// Draw collectible items 3d models on potentially visible cells
+// NOTE: Items added to instances batch, all items drawn at once
+static void DrawCollectibleItems3D(ItemStore items, PickupBatch* batch, Vector3 position, MazeVisibility visibility)
+{
+    float rotationSpeed = 100.0f;
+    float rotationAngle = GetTime() * rotationSpeed;
 
-    while (closedList != NULL)
+    if (visibility.cellCount < items.count)
     {
-        ClosedList* temp = closedList;
-        closedList = closedList->next;
-        free(temp);
+        // Many items, visible cells searched on items cell index
+        for (int i = 0; i < visibility.cellCount; i++)
+        {
+            int item = GetCollectibleItemIndex(items, visibility.cells[i]);
+
+            if (item != -1) AddPickupInstance(batch, (Vector3) { position.x + visibility.cells[i].x, position.y + 0.3f, position.z + visibility.cells[i].y }, items.items[item].color);
+        }
     }
+    else
+    {
+        for (int i = 0; i < items.count; i++)
+        {
+            Point cell = items.items[i].position;
 
-    *pointCount = pathCounter;
+            if (IsMazeCellVisible(visibility, cell)) AddPickupInstance(batch, (Vector3) { position.x + cell.x, position.y + 0.3f, position.z + cell.y }, items.items[i].color);
+        }
+    }
 
-    return path;
-}
\ No newline at end of file
+    DrawPickupBatch(batch, 0.1f, rotationAngle);
+}
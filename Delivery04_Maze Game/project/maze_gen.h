@@ -0,0 +1,496 @@
+/*******************************************************************************************
+*
+*   maze_gen - Procedural maze generator, using Maze Grid Algorithm
+*
+*   Generates maze walkability grids, LoadImageFromMazeGrid() gets the maze image
+*   (Black=Walkable cell, White=Wall/Block cell) when required for textures or meshes.
+*
+*   Generator runs on CPU data only, no window or graphics context required.
+*
+*   Random numbers come from an explicit generator context, never from raylib global state,
+*   the same seed always generates the same maze.
+*
+*   Tiled generator splits the maze in tiles of MAZE_GEN_TILE_SIZE cells, generated in parallel
+*   on worker threads. Every tile uses its own random stream seeded from (seed, tileX, tileY)
+*   and workers stop wall extensions at tile borders, so the maze is the same for any thread
+*   count. Tile width is a multiple of 64 cells, workers never write the same grid words.
+*   Walls are extended in rounds (a slice of every tile points per round), extensions cut at a
+*   tile border are finished after every round on the calling thread, in tiles order: walls
+*   cross tile borders, with the same density along borders as GenMazeGrid() mazes.
+*
+*   CONFIGURATION:
+*       #define MAZE_GEN_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h    - Point type, maze grid
+*       maze_thread.h  - Worker threads for tiled generator
+*       maze_random.h  - Random generator contexts
+*
+********************************************************************************************/
+
+#ifndef MAZE_GEN_H
+#define MAZE_GEN_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid
+#include "maze_thread.h"                // Required for: LoadMazeThread(), UnloadMazeThread()
+#include "maze_random.h"                // Required for: MazeRandom, GetMazeRandomValue()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef MAZE_GEN_TILE_SIZE
+    #define MAZE_GEN_TILE_SIZE      256     // Tiled generator tile size in cells, must be a multiple of 64
+#endif
+#ifndef MAZE_GEN_TILE_ROUNDS
+    #define MAZE_GEN_TILE_ROUNDS    16      // Tiled generator wall extension rounds, cut extensions finished after every round
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeGrid GenMazeGrid(int width, int height, int spacingRows, int spacingCols, float skipChance, MazeRandom* random);    // Generate procedural maze grid, using grid-based algorithm
+MazeGrid GenMazeGridTiled(int width, int height, int spacingRows, int spacingCols, float skipChance, uint64_t seed, int threadCount);   // Generate procedural maze grid in tiles on worker threads (threadCount <= 0: all cores)
+Point GetMazeRandomWalkableCell(MazeGrid map, MazeRandom* random);  // Get random walkable cell, border cells excluded (i.e. benchmark queries)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_GEN_H
+
+/***********************************************************************************
+*
+*   MAZE_GEN IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_GEN_IMPLEMENTATION) && !defined(MAZE_GEN_IMPLEMENTATION_DONE)
+#define MAZE_GEN_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), calloc(), realloc(), free()
+
+// Tiled generator tile, points kept between extension rounds
+typedef struct MazeGenTile
+{
+    int minX;               // Tile bounds, max not included
+    int minY;
+    int maxX;
+    int maxY;
+    MazeRandom random;      // Tile random stream, extension directions drawn on rounds
+    unsigned int* points;   // Shuffled tile points, cell offsets from tile min (y*MAZE_GEN_TILE_SIZE + x)
+    int pointCount;
+} MazeGenTile;
+
+// Wall extension cut at a tile border, finished after extension round
+typedef struct MazeGenCut
+{
+    Point cell;             // First cell out of tile
+    Point direction;        // Extension direction
+    int tile;               // Tile extension started on
+} MazeGenCut;
+
+// Tiled generator worker data, worker processes tiles firstTile, firstTile + tileStep...
+typedef struct MazeGenWorker
+{
+    MazeGrid* maze;
+    MazeGenTile* tiles;
+    int spacingRows;
+    int spacingCols;
+    float skipChance;
+    uint64_t seed;
+    int tileCountX;
+    int tileCount;
+    int firstTile;
+    int tileStep;
+    int round;              // Current extension round, -1 for tiles points setup
+    Point* points;          // Tile points buffer, one per worker
+    MazeGenCut* cuts;       // Extensions cut at tile borders on current round, tiles order
+    int cutCount;
+    int cutCapacity;
+    bool failed;            // Tile points or cuts could not be stored, maze not valid
+} MazeGenWorker;
+
+// Generate procedural maze grid, using grid-based algorithm
+MazeGrid GenMazeGrid(int width, int height, int spacingRows, int spacingCols, float skipChance, MazeRandom* random)
+{
+    // Generate grid of walkable cells
+    MazeGrid maze = LoadMazeGrid(width, height);
+    if (maze.words == NULL) return maze;
+
+    if (spacingRows < 1) spacingRows = 1;
+    if (spacingCols < 1) spacingCols = 1;
+
+    // Allocate an array of point used for maze generation, only cells on spacing lines can be points
+    // NOTE: Dynamic array allocation, memory allocated in HEAP (MAX: Available RAM)
+    size_t mazePointsMax = (size_t)(width/spacingRows + 1) * (height/spacingCols + 1);
+    Point* mazePoints = (Point*)malloc(mazePointsMax * sizeof(Point));
+    int mazePointsCounter = 0;
+
+    if (mazePoints == NULL)
+    {
+        UnloadMazeGrid(maze);
+        return (MazeGrid){ 0 };
+    }
+
+    // Grid border cells set as walls (1 cell)
+    for (int x = 0; x < maze.width; x++)
+    {
+        SetMazeGridCell(&maze, x, 0, true);
+        SetMazeGridCell(&maze, x, maze.height - 1, true);
+    }
+
+    for (int y = 0; y < maze.height; y++)
+    {
+        SetMazeGridCell(&maze, 0, y, true);
+        SetMazeGridCell(&maze, maze.width - 1, y, true);
+    }
+
+    // Start traversing grid cells, line by line, to paint our maze
+    // NOTE: Only cells on spacing lines (corridors width and height) are visited,
+    // in the same order as a full scan, inner cells only
+    for (int y = spacingCols; y < (maze.height - 1); y += spacingCols)
+    {
+        for (int x = spacingRows; x < (maze.width - 1); x += spacingRows)
+        {
+            // Get change to define a point for further processing
+            float chance = (float)GetMazeRandomValue(random, 0, 100) / 100.0f;
+
+            if (chance >= skipChance)
+            {
+                // Set point as wall...
+                SetMazeGridCell(&maze, x, y, true);
+
+                // ...save point for further processing
+                mazePoints[mazePointsCounter] = (Point){ x, y };
+                mazePointsCounter++;
+            }
+        }
+    }
+
+    // Define an array of 4 directions for convenience
+    Point directions[4] = {
+        { 0, -1 },      // Up
+        { 0, 1 },       // Down
+        { -1, 0 },      // Left
+        { 1, 0 },       // Right
+    };
+
+    // Shuffle points in place (Fisher-Yates), so, we process mazePoints[] in random order,
+    // instead of following the order we got them
+    // NOTE: LoadRandomSequence() rejects duplicates with a linear scan, too slow for big mazes
+    for (int i = mazePointsCounter - 1; i > 0; i--)
+    {
+        int j = GetMazeRandomValue(random, 0, i);
+        Point temp = mazePoints[i];
+        mazePoints[i] = mazePoints[j];
+        mazePoints[j] = temp;
+    }
+
+    // Process every random maze point, moving in one random direction,
+    // until we collision with another wall
+    for (int i = 0; i < mazePointsCounter; i++)
+    {
+        Point currentPoint = mazePoints[i];
+        Point currentDir = directions[GetMazeRandomValue(random, 0, 3)];
+        currentPoint.x += currentDir.x;
+        currentPoint.y += currentDir.y;
+
+        // Keep incrementing wall in selected direction until a wall cell is found
+        while (!IsMazeGridWall(maze, currentPoint.x, currentPoint.y))
+        {
+            SetMazeGridCell(&maze, currentPoint.x, currentPoint.y, true);
+
+            currentPoint.x += currentDir.x;
+            currentPoint.y += currentDir.y;
+        }
+    }
+
+    free(mazePoints);
+
+    return maze;
+}
+
+// Load one maze tile: borders and points, same algorithm as GenMazeGrid() inside tile bounds
+// NOTE: Points are shuffled and kept on tile, walls extended on rounds
+static void LoadMazeGenTile(MazeGenWorker* worker, int tile)
+{
+    MazeGrid* maze = worker->maze;
+    MazeGenTile* genTile = &worker->tiles[tile];
+    int tileX = tile % worker->tileCountX;
+    int tileY = tile / worker->tileCountX;
+    int minX = tileX * MAZE_GEN_TILE_SIZE;
+    int minY = tileY * MAZE_GEN_TILE_SIZE;
+    int maxX = (minX + MAZE_GEN_TILE_SIZE < maze->width)? minX + MAZE_GEN_TILE_SIZE : maze->width;
+    int maxY = (minY + MAZE_GEN_TILE_SIZE < maze->height)? minY + MAZE_GEN_TILE_SIZE : maze->height;
+
+    genTile->minX = minX;
+    genTile->minY = minY;
+    genTile->maxX = maxX;
+    genTile->maxY = maxY;
+
+    // Tile random stream only depends on seed and tile coordinates
+    genTile->random = InitMazeRandomStream(worker->seed, ((uint64_t)tileY << 32) | (uint64_t)tileX);
+
+    Point* points = worker->points;
+    int pointsCounter = 0;
+
+    // Grid border cells set as walls (1 cell)
+    for (int x = minX; x < maxX; x++)
+    {
+        if (minY == 0) SetMazeGridCell(maze, x, 0, true);
+        if (maxY == maze->height) SetMazeGridCell(maze, x, maze->height - 1, true);
+    }
+
+    for (int y = minY; y < maxY; y++)
+    {
+        if (minX == 0) SetMazeGridCell(maze, 0, y, true);
+        if (maxX == maze->width) SetMazeGridCell(maze, maze->width - 1, y, true);
+    }
+
+    // Tile points on spacing lines, inner cells only
+    int firstX = ((minX + worker->spacingRows - 1) / worker->spacingRows) * worker->spacingRows;
+    int firstY = ((minY + worker->spacingCols - 1) / worker->spacingCols) * worker->spacingCols;
+    if (firstX == 0) firstX = worker->spacingRows;
+    if (firstY == 0) firstY = worker->spacingCols;
+
+    for (int y = firstY; (y < maxY) && (y < maze->height - 1); y += worker->spacingCols)
+    {
+        for (int x = firstX; (x < maxX) && (x < maze->width - 1); x += worker->spacingRows)
+        {
+            float chance = (float)GetMazeRandomValue(&genTile->random, 0, 100) / 100.0f;
+
+            if (chance >= worker->skipChance)
+            {
+                SetMazeGridCell(maze, x, y, true);
+                points[pointsCounter] = (Point){ x, y };
+                pointsCounter++;
+            }
+        }
+    }
+
+    // Shuffle tile points in place (Fisher-Yates)
+    for (int i = pointsCounter - 1; i > 0; i--)
+    {
+        int j = GetMazeRandomValue(&genTile->random, 0, i);
+        Point temp = points[i];
+        points[i] = points[j];
+        points[j] = temp;
+    }
+
+    // Tile points kept as cell offsets, all tiles points are alive until last round
+    genTile->points = (unsigned int*)malloc(((pointsCounter > 0)? pointsCounter : 1) * sizeof(unsigned int));
+
+    if (genTile->points == NULL)
+    {
+        worker->failed = true;
+        return;
+    }
+
+    for (int i = 0; i < pointsCounter; i++) genTile->points[i] = (points[i].y - minY) * MAZE_GEN_TILE_SIZE + (points[i].x - minX);
+    genTile->pointCount = pointsCounter;
+}
+
+// Extend tile walls for current round points, until a wall cell or the tile border is found
+// NOTE: Only tile cells are read or written, extensions leaving the tile are stored on worker cuts
+static void ExtendMazeGenTile(MazeGenWorker* worker, int tile)
+{
+    MazeGrid* maze = worker->maze;
+    MazeGenTile* genTile = &worker->tiles[tile];
+    int minX = genTile->minX;
+    int minY = genTile->minY;
+    int maxX = genTile->maxX;
+    int maxY = genTile->maxY;
+
+    const Point directions[4] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+
+    int first = (int)((long long)genTile->pointCount * worker->round / MAZE_GEN_TILE_ROUNDS);
+    int last = (int)((long long)genTile->pointCount * (worker->round + 1) / MAZE_GEN_TILE_ROUNDS);
+
+    for (int i = first; i < last; i++)
+    {
+        Point currentPoint = { minX + (int)(genTile->points[i] % MAZE_GEN_TILE_SIZE), minY + (int)(genTile->points[i] / MAZE_GEN_TILE_SIZE) };
+        Point currentDir = directions[GetMazeRandomValue(&genTile->random, 0, 3)];
+        currentPoint.x += currentDir.x;
+        currentPoint.y += currentDir.y;
+
+        while ((currentPoint.x >= minX) && (currentPoint.x < maxX) && (currentPoint.y >= minY) && (currentPoint.y < maxY) &&
+               !IsMazeGridWall(*maze, currentPoint.x, currentPoint.y))
+        {
+            SetMazeGridCell(maze, currentPoint.x, currentPoint.y, true);
+
+            currentPoint.x += currentDir.x;
+            currentPoint.y += currentDir.y;
+        }
+
+        // Out of tile cell state unknown (other workers tile), extension finished after round
+        if ((currentPoint.x < minX) || (currentPoint.x >= maxX) || (currentPoint.y < minY) || (currentPoint.y >= maxY))
+        {
+            if (worker->cutCount == worker->cutCapacity)
+            {
+                int capacity = (worker->cutCapacity > 0)? 2 * worker->cutCapacity : 1024;
+                MazeGenCut* cuts = (MazeGenCut*)realloc(worker->cuts, capacity * sizeof(MazeGenCut));
+
+                if (cuts == NULL)
+                {
+                    worker->failed = true;
+                    return;
+                }
+
+                worker->cuts = cuts;
+                worker->cutCapacity = capacity;
+            }
+
+            worker->cuts[worker->cutCount++] = (MazeGenCut){ currentPoint, currentDir, tile };
+        }
+    }
+}
+
+// Tiled generator worker thread
+static int GenMazeWorker(void* data)
+{
+    MazeGenWorker* worker = (MazeGenWorker*)data;
+
+    for (int tile = worker->firstTile; (tile < worker->tileCount) && !worker->failed; tile += worker->tileStep)
+    {
+        if (worker->round < 0) LoadMazeGenTile(worker, tile);
+        else ExtendMazeGenTile(worker, tile);
+    }
+
+    return 0;
+}
+
+// Run workers for one round, returns false if any worker failed
+// NOTE: Calling thread is worker 0, workers that could not be started run on it too
+static bool RunMazeGenWorkers(MazeGenWorker* workers, MazeThread** threads, int threadCount, int round)
+{
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i].round = round;
+        workers[i].cutCount = 0;
+    }
+
+    for (int i = 1; i < threadCount; i++) threads[i] = LoadMazeThread(GenMazeWorker, &workers[i]);
+
+    GenMazeWorker(&workers[0]);
+
+    bool success = true;
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        if (threads[i] != NULL) UnloadMazeThread(threads[i]);
+        else GenMazeWorker(&workers[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++) if (workers[i].failed) success = false;
+
+    return success;
+}
+
+// Generate procedural maze grid in tiles on worker threads
+// NOTE: Result only depends on seed, not on threadCount or threads scheduling
+MazeGrid GenMazeGridTiled(int width, int height, int spacingRows, int spacingCols, float skipChance, uint64_t seed, int threadCount)
+{
+    MazeGrid maze = LoadMazeGrid(width, height);
+    if (maze.words == NULL) return maze;
+
+    if (spacingRows < 1) spacingRows = 1;
+    if (spacingCols < 1) spacingCols = 1;
+
+    int tileCountX = (width + MAZE_GEN_TILE_SIZE - 1) / MAZE_GEN_TILE_SIZE;
+    int tileCountY = (height + MAZE_GEN_TILE_SIZE - 1) / MAZE_GEN_TILE_SIZE;
+    int tileCount = tileCountX * tileCountY;
+
+    if (threadCount <= 0) threadCount = GetMazeThreadCpuCount();
+    if (threadCount > tileCount) threadCount = tileCount;
+
+    MazeGenTile* tiles = (MazeGenTile*)calloc(tileCount, sizeof(MazeGenTile));
+    MazeGenWorker* workers = (MazeGenWorker*)calloc(threadCount, sizeof(MazeGenWorker));
+    MazeThread** threads = (MazeThread**)calloc(threadCount, sizeof(MazeThread*));
+    size_t tilePointsMax = (size_t)(MAZE_GEN_TILE_SIZE/spacingRows + 1) * (MAZE_GEN_TILE_SIZE/spacingCols + 1);
+    bool ready = (tiles != NULL) && (workers != NULL) && (threads != NULL);
+
+    for (int i = 0; ready && (i < threadCount); i++)
+    {
+        workers[i] = (MazeGenWorker){ &maze, tiles, spacingRows, spacingCols, skipChance, seed, tileCountX, tileCount, i, threadCount, -1, NULL, NULL, 0, 0, false };
+        workers[i].points = (Point*)malloc(tilePointsMax * sizeof(Point));
+        if (workers[i].points == NULL) ready = false;
+    }
+
+    // All tiles points set before any wall extension, same as GenMazeGrid()
+    if (ready) ready = RunMazeGenWorkers(workers, threads, threadCount, -1);
+
+    // Walls extended in rounds, a slice of every tile shuffled points per round
+    // NOTE: Extensions cut at tile borders are finished after every round, so they are not always
+    // the last ones to grow near tile borders (tile borders walls density biased otherwise)
+    for (int round = 0; ready && (round < MAZE_GEN_TILE_ROUNDS); round++)
+    {
+        ready = RunMazeGenWorkers(workers, threads, threadCount, round);
+
+        // Finish cut extensions on calling thread, reading neighbour tiles, in tiles order
+        // NOTE: Worker of tile t is t % threadCount and worker cuts are sorted by tile,
+        // so the maze does not depend on threads count. Extensions can cross several tiles
+        int* cutFinished = (int*)calloc(threadCount, sizeof(int));
+        if (cutFinished == NULL) ready = false;
+
+        for (int tile = 0; ready && (tile < tileCount); tile++)
+        {
+            MazeGenWorker* worker = &workers[tile % threadCount];
+            int* finished = &cutFinished[tile % threadCount];
+
+            while ((*finished < worker->cutCount) && (worker->cuts[*finished].tile == tile))
+            {
+                MazeGenCut cut = worker->cuts[(*finished)++];
+
+                while (!IsMazeGridWall(maze, cut.cell.x, cut.cell.y))
+                {
+                    SetMazeGridCell(&maze, cut.cell.x, cut.cell.y, true);
+
+                    cut.cell.x += cut.direction.x;
+                    cut.cell.y += cut.direction.y;
+                }
+            }
+        }
+
+        free(cutFinished);
+    }
+
+    if (!ready)
+    {
+        UnloadMazeGrid(maze);
+        maze = (MazeGrid){ 0 };
+    }
+
+    for (int i = 0; (tiles != NULL) && (i < tileCount); i++) free(tiles[i].points);
+
+    for (int i = 0; (workers != NULL) && (i < threadCount); i++)
+    {
+        free(workers[i].points);
+        free(workers[i].cuts);
+    }
+
+    free(tiles);
+    free(workers);
+    free(threads);
+
+    return maze;
+}
+
+// Get random walkable cell, border cells excluded
+// NOTE: Map must have walkable cells, generated mazes always do
+Point GetMazeRandomWalkableCell(MazeGrid map, MazeRandom* random)
+{
+    Point cell = { 0 };
+
+    do
+    {
+        cell = (Point){ GetMazeRandomValue(random, 1, map.width - 2), GetMazeRandomValue(random, 1, map.height - 2) };
+    } while (!IsCellWalkable(map, cell.x, cell.y));
+
+    return cell;
+}
+
+#endif // MAZE_GEN_IMPLEMENTATION
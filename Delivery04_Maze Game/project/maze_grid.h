@@ -0,0 +1,351 @@
+/*******************************************************************************************
+*
+*   maze_grid - Maze walkability grid, 1 bit per cell
+*
+*   Single authoritative map data for gameplay queries: collisions, pathfinding, items
+*   placement and drawing. Maze image is only kept for GPU uploads (texture, cubicmap mesh),
+*   it must be updated together with the grid on map edits.
+*
+*   Cells are packed in 64-bit words, one row after another, bit set for Wall/Block cells.
+*   Row padding bits (x >= width) are set as walls, so row scans always stop at the row end.
+*   Grids up to MAZE_GRID_MAX_SIZE cells per side are supported (32 MB at 16384x16384).
+*
+*   Maze grid file format (.maze), little-endian:
+*       4 bytes     "MAZE" file id
+*       4 bytes     Format version (1)
+*       4 bytes     Width in cells
+*       4 bytes     Height in cells
+*       N bytes     Cells, one row after another, (width + 7)/8 bytes per row,
+*                   cell (x, y) is bit x%8 of row byte x/8, bit set for Wall/Block cells
+*
+*   CONFIGURATION:
+*       #define MAZE_GRID_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+********************************************************************************************/
+
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include "raylib.h"
+#include <stddef.h>                     // Required for: size_t
+#include <stdint.h>                     // Required for: uint64_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef MAZE_GRID_MAX_SIZE
+    #define MAZE_GRID_MAX_SIZE      16384   // Max grid width/height, cell indices always fit in int
+#endif
+
+// Declare new data type: Point
+typedef struct Point
+{
+    int x;
+    int y;
+} Point;
+
+// Maze walkability grid, bit set for Wall/Block cells
+typedef struct MazeGrid
+{
+    int width;              // Grid width in cells
+    int height;             // Grid height in cells
+    int rowWords;           // Words per row, (width + 63)/64
+    uint64_t* words;        // Cells bits (rowWords*height), cell (x, y) is bit x%64 of word y*rowWords + x/64
+} MazeGrid;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeGrid LoadMazeGrid(int width, int height);                       // Load maze grid of given size, all cells walkable
+MazeGrid LoadMazeGridFromImage(Image image);                        // Load maze grid from maze image (Black=Walkable cell, White=Wall/Block cell)
+Image LoadImageFromMazeGrid(MazeGrid grid);                         // Load maze image from maze grid (GRAYSCALE, 1 byte per cell)
+void UnloadMazeGrid(MazeGrid grid);                                 // Unload maze grid data
+MazeGrid LoadMazeGridFile(const char* fileName);                    // Load maze grid from maze grid file (.maze)
+bool ExportMazeGrid(MazeGrid grid, const char* fileName);           // Export maze grid to maze grid file (.maze), returns true on success
+
+#if defined(__cplusplus)
+}
+#endif
+
+// Check if grid cell is a wall, out-of-bounds cells are walls
+static inline bool IsMazeGridWall(MazeGrid grid, int x, int y)
+{
+    if (((unsigned int)x >= (unsigned int)grid.width) || ((unsigned int)y >= (unsigned int)grid.height)) return true;
+
+    return (grid.words[(size_t)y * grid.rowWords + (x >> 6)] >> (x & 63)) & 1;
+}
+
+// Check if grid cell is walkable, out-of-bounds cells are not walkable
+static inline bool IsCellWalkable(MazeGrid grid, int x, int y)
+{
+    return !IsMazeGridWall(grid, x, y);
+}
+
+// Set grid cell as wall or walkable, out-of-bounds cells are ignored
+static inline void SetMazeGridCell(MazeGrid* grid, int x, int y, bool wall)
+{
+    if (((unsigned int)x >= (unsigned int)grid->width) || ((unsigned int)y >= (unsigned int)grid->height)) return;
+
+    uint64_t* word = &grid->words[(size_t)y * grid->rowWords + (x >> 6)];
+
+    if (wall) *word |= (1ULL << (x & 63));
+    else *word &= ~(1ULL << (x & 63));
+}
+
+// Get 64 cells of a grid row, bit i is cell (64*index + i, y), out-of-bounds cells are walls
+static inline uint64_t GetMazeGridRowWord(MazeGrid grid, int y, int index)
+{
+    if (((unsigned int)y >= (unsigned int)grid.height) || ((unsigned int)index >= (unsigned int)grid.rowWords)) return ~0ULL;
+
+    return grid.words[(size_t)y * grid.rowWords + index];
+}
+
+// Get index of lowest bit set, word must not be 0
+static inline int GetMazeGridLowestBit(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while (!((word >> index) & 1)) index++;
+    return index;
+#endif
+}
+
+// Get index of highest bit set, word must not be 0
+static inline int GetMazeGridHighestBit(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(word);
+#else
+    int index = 63;
+    while (!((word >> index) & 1)) index--;
+    return index;
+#endif
+}
+
+// Get number of bits set in word
+static inline int GetMazeGridBitCount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1) count++;
+    return count;
+#endif
+}
+
+#endif // MAZE_GRID_H
+
+/***********************************************************************************
+*
+*   MAZE_GRID IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_GRID_IMPLEMENTATION) && !defined(MAZE_GRID_IMPLEMENTATION_DONE)
+#define MAZE_GRID_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: calloc(), malloc(), free()
+#include <string.h>                     // Required for: memset(), memcpy(), memcmp()
+
+// Load maze grid of given size, all cells walkable
+MazeGrid LoadMazeGrid(int width, int height)
+{
+    MazeGrid grid = { 0 };
+
+    if ((width <= 0) || (height <= 0)) return grid;
+    if ((width > MAZE_GRID_MAX_SIZE) || (height > MAZE_GRID_MAX_SIZE))
+    {
+        TraceLog(LOG_WARNING, "MAZE: Grid size %ix%i over max size %ix%i", width, height, MAZE_GRID_MAX_SIZE, MAZE_GRID_MAX_SIZE);
+        return grid;
+    }
+
+    grid.rowWords = (width + 63) / 64;
+    grid.words = (uint64_t*)calloc((size_t)grid.rowWords * height, sizeof(uint64_t));
+    if (grid.words == NULL) return (MazeGrid){ 0 };
+
+    grid.width = width;
+    grid.height = height;
+
+    // Row padding cells are walls
+    if (width % 64 != 0)
+    {
+        uint64_t padding = ~0ULL << (width % 64);
+        for (int y = 0; y < height; y++) grid.words[(size_t)y * grid.rowWords + grid.rowWords - 1] = padding;
+    }
+
+    return grid;
+}
+
+// Load maze grid from maze image
+// NOTE: Only red channel is checked, any value but 0 is a wall
+MazeGrid LoadMazeGridFromImage(Image image)
+{
+    MazeGrid grid = LoadMazeGrid(image.width, image.height);
+
+    if (grid.words == NULL) return grid;
+
+    if (image.format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE)
+    {
+        // Maze images are generated as GRAYSCALE, avoid per-pixel format decoding in that case
+        const unsigned char* pixels = (const unsigned char*)image.data;
+
+        for (int y = 0; y < image.height; y++)
+        {
+            for (int x = 0; x < image.width; x++) if (pixels[(size_t)y * image.width + x] != 0) SetMazeGridCell(&grid, x, y, true);
+        }
+    }
+    else if (image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        const Color* pixels = (const Color*)image.data;
+
+        for (int y = 0; y < image.height; y++)
+        {
+            for (int x = 0; x < image.width; x++) if (pixels[(size_t)y * image.width + x].r != 0) SetMazeGridCell(&grid, x, y, true);
+        }
+    }
+    else
+    {
+        for (int y = 0; y < image.height; y++)
+        {
+            for (int x = 0; x < image.width; x++) if (GetImageColor(image, x, y).r != 0) SetMazeGridCell(&grid, x, y, true);
+        }
+    }
+
+    return grid;
+}
+
+// Load maze image from maze grid
+// NOTE: Black=Walkable cell, White=Wall/Block cell, 1 byte per cell keeps big maze images at 256 MB max
+Image LoadImageFromMazeGrid(MazeGrid grid)
+{
+    Image image = { 0 };
+
+    if (grid.words == NULL) return image;
+
+    unsigned char* pixels = (unsigned char*)malloc((size_t)grid.width * grid.height);
+    if (pixels == NULL) return image;
+
+    for (int y = 0; y < grid.height; y++)
+    {
+        unsigned char* row = pixels + (size_t)y * grid.width;
+
+        for (int x = 0; x < grid.width; x += 64)
+        {
+            uint64_t word = grid.words[(size_t)y * grid.rowWords + (x >> 6)];
+            int count = (grid.width - x < 64)? grid.width - x : 64;
+
+            // Full words of walkable or wall cells are common on mazes, filled at once
+            if ((word == 0) || (word == ~0ULL)) memset(row + x, (word == 0)? 0 : 255, count);
+            else for (int i = 0; i < count; i++) row[x + i] = ((word >> i) & 1)? 255 : 0;
+        }
+    }
+
+    image.data = pixels;
+    image.width = grid.width;
+    image.height = grid.height;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+
+    return image;
+}
+
+// Unload maze grid data
+void UnloadMazeGrid(MazeGrid grid)
+{
+    free(grid.words);
+}
+
+// Maze grid file header size in bytes
+#define MAZE_GRID_FILE_HEADER_SIZE  16
+
+// Read/write 32-bit little-endian values, files are the same on any platform
+static unsigned int MazeGridReadUint32(const unsigned char* bytes)
+{
+    return (unsigned int)bytes[0] | ((unsigned int)bytes[1] << 8) | ((unsigned int)bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+static void MazeGridWriteUint32(unsigned char* bytes, unsigned int value)
+{
+    for (int i = 0; i < 4; i++) bytes[i] = (unsigned char)(value >> (8 * i));
+}
+
+// Load maze grid from maze grid file
+MazeGrid LoadMazeGridFile(const char* fileName)
+{
+    MazeGrid grid = { 0 };
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(fileName, &dataSize);
+
+    if (data == NULL) return grid;
+
+    if ((dataSize < MAZE_GRID_FILE_HEADER_SIZE) || (memcmp(data, "MAZE", 4) != 0) || (MazeGridReadUint32(data + 4) != 1))
+    {
+        TraceLog(LOG_WARNING, "MAZE: [%s] Not a valid maze grid file", fileName);
+        UnloadFileData(data);
+        return grid;
+    }
+
+    unsigned int width = MazeGridReadUint32(data + 8);
+    unsigned int height = MazeGridReadUint32(data + 12);
+    size_t rowBytes = (width + 7) / 8;
+
+    if ((width > MAZE_GRID_MAX_SIZE) || (height > MAZE_GRID_MAX_SIZE) || ((size_t)dataSize < MAZE_GRID_FILE_HEADER_SIZE + rowBytes * height))
+    {
+        TraceLog(LOG_WARNING, "MAZE: [%s] Maze grid file size not valid", fileName);
+        UnloadFileData(data);
+        return grid;
+    }
+
+    grid = LoadMazeGrid((int)width, (int)height);
+
+    for (int y = 0; (grid.words != NULL) && (y < grid.height); y++)
+    {
+        const unsigned char* row = data + MAZE_GRID_FILE_HEADER_SIZE + rowBytes * y;
+
+        for (size_t i = 0; i < rowBytes; i++) grid.words[(size_t)y * grid.rowWords + i / 8] |= (uint64_t)row[i] << (8 * (i % 8));
+    }
+
+    UnloadFileData(data);
+
+    return grid;
+}
+
+// Export maze grid to maze grid file
+bool ExportMazeGrid(MazeGrid grid, const char* fileName)
+{
+    if (grid.words == NULL) return false;
+
+    size_t rowBytes = ((size_t)grid.width + 7) / 8;
+    size_t dataSize = MAZE_GRID_FILE_HEADER_SIZE + rowBytes * grid.height;
+    unsigned char* data = (unsigned char*)malloc(dataSize);
+
+    if (data == NULL) return false;
+
+    memcpy(data, "MAZE", 4);
+    MazeGridWriteUint32(data + 4, 1);
+    MazeGridWriteUint32(data + 8, (unsigned int)grid.width);
+    MazeGridWriteUint32(data + 12, (unsigned int)grid.height);
+
+    for (int y = 0; y < grid.height; y++)
+    {
+        unsigned char* row = data + MAZE_GRID_FILE_HEADER_SIZE + rowBytes * y;
+
+        for (size_t i = 0; i < rowBytes; i++) row[i] = (unsigned char)(grid.words[(size_t)y * grid.rowWords + i / 8] >> (8 * (i % 8)));
+
+        // Row padding bits are walls on grid, saved as 0
+        if (grid.width % 8 != 0) row[rowBytes - 1] &= (unsigned char)((1u << (grid.width % 8)) - 1);
+    }
+
+    bool success = SaveFileData(fileName, data, (int)dataSize);
+    free(data);
+
+    return success;
+}
+
+#endif // MAZE_GRID_IMPLEMENTATION
@@ -0,0 +1,442 @@
+/*******************************************************************************************
+*
+*   maze_items - Collectible items store and placement on maze grids
+*
+*   Items store keeps live items in a compact array (collected items are removed by
+*   swapping the last item in their place) and a cell index, so finding the item on a
+*   cell is O(1) whatever the number of items: cell index is a hash table from cell to
+*   item, its size depends on store capacity, not on maze size.
+*
+*   Only one item per cell. Store capacity is set on load, at runtime.
+*
+*   Items are placed on random walkable cells, never on maze start or end cells,
+*   item values (1 to 3) and colors are also random. The random context is passed
+*   explicitly, so the same seed always places the same items.
+*
+*   Placement draws cells without replacement from the maze free cells (partial Fisher-Yates
+*   shuffle), so it always ends, even on full mazes: every draw takes a new free cell.
+*   Free cells list is virtual, cells are found from their rank with the free cells count
+*   of every grid word, only the list entries moved by the shuffle are stored.
+*   Items min spacing is checked on an occupancy bitset (one bit per cell, grid words layout),
+*   a few words per row around the drawn cell instead of one item lookup per cell.
+*
+*   CONFIGURATION:
+*       #define MAZE_ITEMS_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h   - Point type and map cells walkability bits
+*       maze_random.h - Random generator contexts
+*
+********************************************************************************************/
+
+#ifndef MAZE_ITEMS_H
+#define MAZE_ITEMS_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, GetMazeGridBitCount()
+#include "maze_random.h"                // Required for: MazeRandom, GetMazeRandomValue()
+
+// Collectible item
+typedef struct CollectibleItem
+{
+    Point position;             // Item cell
+    int value;                  // Item score value (1 to 3)
+    Color color;                // Item color, depends on value
+} CollectibleItem;
+
+// Collectible items store, live items only
+typedef struct ItemStore
+{
+    CollectibleItem* items;     // Live items, compact array (order changes on remove)
+    int count;                  // Live items count
+    int capacity;               // Max items count
+    int* cellIndex;             // Cell index hash table: item index for every slot, -1 if empty slot
+    int cellIndexMask;          // Cell index slots count - 1 (power of two)
+} ItemStore;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+ItemStore LoadItemStore(int capacity);                                  // Load items store for a max number of items
+void UnloadItemStore(ItemStore store);                                  // Unload items store data
+void ClearItemStore(ItemStore* store);                                  // Remove all items from store
+int AddCollectibleItem(ItemStore* store, CollectibleItem item);        // Add item to store, returns item index (-1 if store full or cell already used)
+void RemoveCollectibleItem(ItemStore* store, int index);                // Remove item from store, last item moved to its index
+int GetCollectibleItemIndex(ItemStore store, Point cell);               // Get index of item on cell, -1 if no item
+
+CollectibleItem GenCollectibleItem(MazeRandom* random, Point position); // Generate item with random value on cell
+
+// Set collectible items in the maze, items are not placed on the 4 start cells or the 4 end cells
+// NOTE: Store is cleared first, items are at least minSpacing cells apart (0 or 1: any free cell),
+// returns items placed, lower than itemCount if maze has not enough free cells or store capacity
+int SetCollectibleItems(MazeGrid mazeGrid, MazeRandom* random, const Point startCells[4], const Point endCells[4], ItemStore* store, int itemCount, int minSpacing);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_ITEMS_H
+
+/***********************************************************************************
+*
+*   MAZE_ITEMS IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_ITEMS_IMPLEMENTATION) && !defined(MAZE_ITEMS_IMPLEMENTATION_DONE)
+#define MAZE_ITEMS_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), calloc(), free()
+#include <stdint.h>                     // Required for: uint64_t
+
+// Items placement swap map, virtual free cells list entries moved by the shuffle
+// NOTE: Only moved entries are stored, placement memory depends on items drawn, not on maze size
+typedef struct ItemsSwap
+{
+    int index;                  // Free cells list index, -1 if empty slot
+    int rank;                   // Free cell rank at that list index
+} ItemsSwap;
+
+typedef struct ItemsSwapMap
+{
+    ItemsSwap* slots;           // Hash table slots, linear probing
+    int mask;                   // Slots count - 1 (power of two)
+    int count;                  // Used slots count
+} ItemsSwapMap;
+
+// Get cell index first slot for a cell (Fibonacci hashing)
+static inline int ItemStoreCellSlot(ItemStore store, Point cell)
+{
+    uint64_t key = ((uint64_t)(uint32_t)cell.y << 32) | (uint32_t)cell.x;
+
+    return (int)((key * 0x9E3779B97F4A7C15ULL) >> 32) & store.cellIndexMask;
+}
+
+// Get cell index slot containing cell item, or empty slot where it would be added
+static int ItemStoreFindSlot(ItemStore store, Point cell)
+{
+    int slot = ItemStoreCellSlot(store, cell);
+
+    while (store.cellIndex[slot] != -1)
+    {
+        Point position = store.items[store.cellIndex[slot]].position;
+        if ((position.x == cell.x) && (position.y == cell.y)) break;
+
+        slot = (slot + 1) & store.cellIndexMask;
+    }
+
+    return slot;
+}
+
+// Load items store for a max number of items
+// NOTE: Cell index has at least twice the slots of max items, probe sequences stay short
+ItemStore LoadItemStore(int capacity)
+{
+    ItemStore store = { 0 };
+    if (capacity < 1) capacity = 1;
+
+    int slotCount = 2;
+    while (slotCount < 2 * capacity) slotCount *= 2;
+
+    store.items = (CollectibleItem*)malloc(capacity * sizeof(CollectibleItem));
+    store.cellIndex = (int*)malloc(slotCount * sizeof(int));
+
+    if ((store.items == NULL) || (store.cellIndex == NULL))
+    {
+        UnloadItemStore(store);
+        return (ItemStore){ 0 };
+    }
+
+    store.capacity = capacity;
+    store.cellIndexMask = slotCount - 1;
+    for (int i = 0; i < slotCount; i++) store.cellIndex[i] = -1;
+
+    return store;
+}
+
+// Unload items store data
+void UnloadItemStore(ItemStore store)
+{
+    free(store.items);
+    free(store.cellIndex);
+}
+
+// Remove all items from store
+// NOTE: Only used slots are cleared: every item slot is in the used slots run starting at its first slot,
+// clearing the run up to the next empty slot removes it (all items are removed, any run part can be cleared)
+void ClearItemStore(ItemStore* store)
+{
+    for (int i = 0; i < store->count; i++)
+    {
+        for (int slot = ItemStoreCellSlot(*store, store->items[i].position); store->cellIndex[slot] != -1; slot = (slot + 1) & store->cellIndexMask) store->cellIndex[slot] = -1;
+    }
+
+    store->count = 0;
+}
+
+// Add item to store
+int AddCollectibleItem(ItemStore* store, CollectibleItem item)
+{
+    if (store->count >= store->capacity) return -1;
+
+    int slot = ItemStoreFindSlot(*store, item.position);
+    if (store->cellIndex[slot] != -1) return -1;
+
+    store->items[store->count] = item;
+    store->cellIndex[slot] = store->count;
+
+    return store->count++;
+}
+
+// Remove item from store, last item moved to its index
+// NOTE: Empty slot is filled shifting back next slots of the probe sequence (no tombstones)
+void RemoveCollectibleItem(ItemStore* store, int index)
+{
+    if ((index < 0) || (index >= store->count)) return;
+
+    int slot = ItemStoreFindSlot(*store, store->items[index].position);
+    int next = slot;
+
+    while (true)
+    {
+        next = (next + 1) & store->cellIndexMask;
+        if (store->cellIndex[next] == -1) break;
+
+        // Slot entry can only move back if its first slot is not between empty slot and itself
+        int first = ItemStoreCellSlot(*store, store->items[store->cellIndex[next]].position);
+        if (((next - first) & store->cellIndexMask) >= ((next - slot) & store->cellIndexMask))
+        {
+            store->cellIndex[slot] = store->cellIndex[next];
+            slot = next;
+        }
+    }
+
+    store->cellIndex[slot] = -1;
+
+    // Move last item to removed item index, cell index updated
+    int last = store->count - 1;
+    if (index != last)
+    {
+        store->items[index] = store->items[last];
+        store->cellIndex[ItemStoreFindSlot(*store, store->items[index].position)] = index;
+    }
+
+    store->count--;
+}
+
+// Get index of item on cell
+int GetCollectibleItemIndex(ItemStore store, Point cell)
+{
+    if (store.count == 0) return -1;
+
+    return store.cellIndex[ItemStoreFindSlot(store, cell)];
+}
+
+// Generate item with random value on cell
+CollectibleItem GenCollectibleItem(MazeRandom* random, Point position)
+{
+    CollectibleItem item = { 0 };
+
+    item.position = position;
+    item.value = GetMazeRandomValue(random, 1, 3);
+
+    // Set color based on value
+    switch (item.value) {
+    case 1: item.color = ORANGE; break;
+    case 2: item.color = RAYWHITE; break;
+    case 3: item.color = PURPLE; break;
+    default: break;
+    }
+
+    return item;
+}
+
+// Placement swap map entry slots for a number of entries
+static bool LoadItemsSwapMap(ItemsSwapMap* map, int entries)
+{
+    int slotCount = 16;
+    while (slotCount < 2 * entries) slotCount *= 2;
+
+    map->slots = (ItemsSwap*)malloc(slotCount * sizeof(ItemsSwap));
+    map->mask = slotCount - 1;
+    map->count = 0;
+
+    if (map->slots == NULL) return false;
+
+    for (int i = 0; i < slotCount; i++) map->slots[i].index = -1;
+
+    return true;
+}
+
+// Get placement swap map slot containing list index, or empty slot where it would be added
+static inline int GetItemsSwapSlot(ItemsSwapMap map, int index)
+{
+    int slot = (int)(((uint64_t)(uint32_t)index * 0x9E3779B97F4A7C15ULL) >> 32) & map.mask;
+
+    while ((map.slots[slot].index != -1) && (map.slots[slot].index != index)) slot = (slot + 1) & map.mask;
+
+    return slot;
+}
+
+// Get free cell rank at virtual free cells list index
+static inline int GetItemsSwap(ItemsSwapMap map, int index)
+{
+    int slot = GetItemsSwapSlot(map, index);
+
+    return (map.slots[slot].index == -1)? index : map.slots[slot].rank;
+}
+
+// Set free cell rank at virtual free cells list index, map grows when half full
+static bool SetItemsSwap(ItemsSwapMap* map, int index, int rank)
+{
+    if (2 * (map->count + 1) > map->mask + 1)
+    {
+        ItemsSwapMap grown = { 0 };
+        if (!LoadItemsSwapMap(&grown, map->mask + 1)) return false;
+
+        for (int i = 0; i <= map->mask; i++)
+        {
+            if (map->slots[i].index == -1) continue;
+
+            grown.slots[GetItemsSwapSlot(grown, map->slots[i].index)] = map->slots[i];
+            grown.count++;
+        }
+
+        free(map->slots);
+        *map = grown;
+    }
+
+    int slot = GetItemsSwapSlot(*map, index);
+    if (map->slots[slot].index == -1) map->count++;
+
+    map->slots[slot] = (ItemsSwap){ index, rank };
+
+    return true;
+}
+
+// Get free cell from its rank, free cells ordered one row after another
+// NOTE: wordFreeCounts contains free cells count before every grid word
+static Point GetItemsFreeCell(MazeGrid grid, const unsigned int* wordFreeCounts, int wordCount, int rank)
+{
+    // Binary search of last word with less free cells before it than rank + 1
+    // NOTE: Search range halved without branches (conditional move), draws are random and
+    // search branches would be mispredicted half the time
+    const unsigned int* word = wordFreeCounts;
+    int count = wordCount;
+
+    while (count > 1)
+    {
+        int half = count / 2;
+
+        word = (word[half] <= (unsigned int)rank)? word + half : word;
+        count -= half;
+    }
+
+    int low = (int)(word - wordFreeCounts);
+
+    // Free cells are the bits not set, remove free cells before rank
+    uint64_t freeBits = ~grid.words[low];
+    for (int i = rank - (int)wordFreeCounts[low]; i > 0; i--) freeBits &= freeBits - 1;
+
+    return (Point){ (low % grid.rowWords) * 64 + GetMazeGridLowestBit(freeBits), low / grid.rowWords };
+}
+
+// Check if item can be placed on cell: not a start or end cell, no other item closer than minSpacing cells
+// NOTE: Occupied cells bitset has grid words layout, only used for spacing over 1 (NULL otherwise):
+// cells are drawn only once, spacing 0 or 1 never finds an item on cell
+static bool IsItemCellAvailable(MazeGrid grid, const uint64_t* occupied, const Point startCells[4], const Point endCells[4], Point cell, int minSpacing)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (((cell.x == startCells[i].x) && (cell.y == startCells[i].y)) ||
+            ((cell.x == endCells[i].x) && (cell.y == endCells[i].y))) return false;
+    }
+
+    if (occupied == NULL) return true;
+
+    int minX = (cell.x - minSpacing + 1 > 0)? cell.x - minSpacing + 1 : 0;
+    int maxX = (cell.x + minSpacing - 1 < grid.width - 1)? cell.x + minSpacing - 1 : grid.width - 1;
+    int minY = (cell.y - minSpacing + 1 > 0)? cell.y - minSpacing + 1 : 0;
+    int maxY = (cell.y + minSpacing - 1 < grid.height - 1)? cell.y + minSpacing - 1 : grid.height - 1;
+
+    // Row cells [minX, maxX] checked a word at a time
+    for (int y = minY; y <= maxY; y++)
+    {
+        const uint64_t* row = occupied + (size_t)y * grid.rowWords;
+
+        for (int w = minX >> 6; w <= (maxX >> 6); w++)
+        {
+            uint64_t mask = ~0ULL;
+            if (w == (minX >> 6)) mask &= ~0ULL << (minX & 63);
+            if (w == (maxX >> 6)) mask &= ~0ULL >> (63 - (maxX & 63));
+
+            if (row[w] & mask) return false;
+        }
+    }
+
+    return true;
+}
+
+// Set collectible items in the maze
+int SetCollectibleItems(MazeGrid mazeGrid, MazeRandom* random, const Point startCells[4], const Point endCells[4], ItemStore* store, int itemCount, int minSpacing)
+{
+    ClearItemStore(store);
+
+    if (itemCount > store->capacity) itemCount = store->capacity;
+    if ((itemCount <= 0) || (mazeGrid.words == NULL)) return 0;
+    if (minSpacing < 1) minSpacing = 1;
+
+    // Free cells count before every grid word, row padding bits are walls
+    int wordCount = mazeGrid.rowWords * mazeGrid.height;
+    unsigned int* wordFreeCounts = (unsigned int*)malloc(wordCount * sizeof(unsigned int));
+    if (wordFreeCounts == NULL) return 0;
+
+    int freeCount = 0;
+
+    for (int i = 0; i < wordCount; i++)
+    {
+        wordFreeCounts[i] = (unsigned int)freeCount;
+        freeCount += 64 - GetMazeGridBitCount(mazeGrid.words[i]);
+    }
+
+    // NOTE: Map grows if spacing rejects cells, more draws than items required
+    ItemsSwapMap swaps = { 0 };
+    uint64_t* occupied = (minSpacing > 1)? (uint64_t*)calloc(wordCount, sizeof(uint64_t)) : NULL;
+
+    if (((minSpacing > 1) && (occupied == NULL)) || !LoadItemsSwapMap(&swaps, (itemCount < freeCount)? itemCount : freeCount))
+    {
+        free(wordFreeCounts);
+        free(occupied);
+        free(swaps.slots);
+        return 0;
+    }
+
+    // Partial Fisher-Yates shuffle of virtual free cells list (list[i] = i until moved),
+    // list index i takes a random entry from the not drawn ones, drawn entry replaced by list[i]
+    for (int i = 0; (i < freeCount) && (store->count < itemCount); i++)
+    {
+        int j = GetMazeRandomValue(random, i, freeCount - 1);
+        int rank = GetItemsSwap(swaps, j);
+
+        if ((j != i) && !SetItemsSwap(&swaps, j, GetItemsSwap(swaps, i))) break;
+
+        Point cell = GetItemsFreeCell(mazeGrid, wordFreeCounts, wordCount, rank);
+
+        if (IsItemCellAvailable(mazeGrid, occupied, startCells, endCells, cell, minSpacing))
+        {
+            AddCollectibleItem(store, GenCollectibleItem(random, cell));
+            if (occupied != NULL) occupied[(size_t)cell.y * mazeGrid.rowWords + (cell.x >> 6)] |= 1ULL << (cell.x & 63);
+        }
+    }
+
+    free(wordFreeCounts);
+    free(occupied);
+    free(swaps.slots);
+
+    return store->count;
+}
+
+#endif // MAZE_ITEMS_IMPLEMENTATION
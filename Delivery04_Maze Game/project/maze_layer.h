@@ -0,0 +1,289 @@
+/*******************************************************************************************
+*
+*   maze_layer - Cached 2d tiles layer for maze grids
+*
+*   Maze floor and wall tiles are drawn once into render textures, one per chunk of
+*   MAZE_LAYER_CHUNK_SIZE x MAZE_LAYER_CHUNK_SIZE cells, then every frame only a textured
+*   quad per visible chunk is drawn (one draw call for the default 64x64 maze).
+*
+*   Chunks are redrawn only when dirty: map cells edited, tileset changed (biome), or chunk
+*   render texture reused for another chunk. Render textures loaded are enough for the biggest
+*   view (min zoom), least recently used ones are reused, so big mazes only keep visible chunks
+*   in VRAM. Every visible chunk always gets a render texture, more are loaded if required.
+*
+*   Tileset texture contains wall tile at (0, height/2) and floor tile at (width/2, height/2),
+*   each one (width/2 x height/2), same as maze biome atlas textures.
+*
+*   NOTE: Chunks are drawn into render textures on UpdateMazeLayer(), it must be called out
+*   of BeginMode2D()/EndMode2D(), texture mode resets 2d camera transform.
+*
+*   CONFIGURATION:
+*       #define MAZE_LAYER_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Map cells walkability
+*
+********************************************************************************************/
+
+#ifndef MAZE_LAYER_H
+#define MAZE_LAYER_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsMazeGridWall()
+
+#ifndef MAZE_LAYER_CHUNK_SIZE
+    #define MAZE_LAYER_CHUNK_SIZE   64      // Chunk width and height, in cells
+#endif
+
+// Layer chunk, cached tiles of a maze area
+typedef struct MazeLayerChunk
+{
+    Point chunk;                // Chunk coordinates, in chunks
+    RenderTexture2D target;     // Chunk tiles render texture
+    bool dirty;                 // Tiles must be drawn again
+    unsigned int lastUsed;      // Last update chunk was visible, least recently used chunks are reused
+} MazeLayerChunk;
+
+// Cached 2d tiles layer
+typedef struct MazeLayer
+{
+    int width;                  // Map width in cells
+    int height;                 // Map height in cells
+    float cellSize;             // Cell size, in pixels
+    Texture2D tileset;          // Tiles texture, not owned by layer
+    MazeLayerChunk* chunks;     // Loaded chunks
+    int chunkCount;             // Loaded chunks count
+    int maxChunks;              // Max chunks loaded (visible chunks on biggest view), exceeded only if more chunks are visible
+    unsigned int updateCount;   // Updates counter, chunks use time
+} MazeLayer;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeLayer LoadMazeLayer(int width, int height, float cellSize, Texture2D tileset, Vector2 maxViewSize);  // Load layer for a map of given size, chunks loaded when visible, biggest view size in world units
+void UnloadMazeLayer(MazeLayer layer);                                  // Unload layer chunks render textures
+void SetMazeLayerTileset(MazeLayer* layer, Texture2D tileset);          // Set tiles texture, all chunks drawn again
+void SetMazeLayerCellDirty(MazeLayer* layer, Point cell);               // Set cell chunk to be drawn again (map cell edited)
+void UpdateMazeLayer(MazeLayer* layer, MazeGrid map, Vector2 position, Rectangle view);  // Draw dirty or new visible chunks tiles, view in world coordinates
+void DrawMazeLayer(MazeLayer layer, Vector2 position, Rectangle view);  // Draw visible chunks, layer top-left corner at position
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_LAYER_H
+
+/***********************************************************************************
+*
+*   MAZE_LAYER IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_LAYER_IMPLEMENTATION) && !defined(MAZE_LAYER_IMPLEMENTATION_DONE)
+#define MAZE_LAYER_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), realloc(), free()
+
+// Get visible chunks range for a view, chunks coordinates
+static void GetMazeLayerViewChunks(MazeLayer layer, Vector2 position, Rectangle view, Point* min, Point* max)
+{
+    float chunkSize = MAZE_LAYER_CHUNK_SIZE * layer.cellSize;
+    int chunksX = (layer.width + MAZE_LAYER_CHUNK_SIZE - 1) / MAZE_LAYER_CHUNK_SIZE;
+    int chunksY = (layer.height + MAZE_LAYER_CHUNK_SIZE - 1) / MAZE_LAYER_CHUNK_SIZE;
+
+    min->x = (int)((view.x - position.x) / chunkSize);
+    min->y = (int)((view.y - position.y) / chunkSize);
+    max->x = (int)((view.x + view.width - position.x) / chunkSize);
+    max->y = (int)((view.y + view.height - position.y) / chunkSize);
+
+    if (min->x < 0) min->x = 0;
+    if (min->y < 0) min->y = 0;
+    if (max->x > chunksX - 1) max->x = chunksX - 1;
+    if (max->y > chunksY - 1) max->y = chunksY - 1;
+}
+
+// Find loaded chunk, NULL if not loaded
+static MazeLayerChunk* FindMazeLayerChunk(MazeLayer* layer, Point chunk)
+{
+    for (int i = 0; i < layer->chunkCount; i++)
+    {
+        if ((layer->chunks[i].chunk.x == chunk.x) && (layer->chunks[i].chunk.y == chunk.y)) return &layer->chunks[i];
+    }
+
+    return NULL;
+}
+
+// Draw cells tiles in range [min, max), cell min drawn at position
+static void DrawMazeLayerTiles(MazeLayer layer, MazeGrid map, Point min, Point max, Vector2 position)
+{
+    Rectangle wallTile = { 0, layer.tileset.height / 2, layer.tileset.width / 2, layer.tileset.height / 2 };
+    Rectangle floorTile = { layer.tileset.width / 2, layer.tileset.height / 2, layer.tileset.width / 2, layer.tileset.height / 2 };
+
+    if (max.x > map.width) max.x = map.width;
+    if (max.y > map.height) max.y = map.height;
+
+    for (int y = min.y; y < max.y; y++)
+    {
+        for (int x = min.x; x < max.x; x++)
+        {
+            Rectangle cell = { position.x + (x - min.x) * layer.cellSize, position.y + (y - min.y) * layer.cellSize, layer.cellSize, layer.cellSize };
+
+            DrawTexturePro(layer.tileset, IsMazeGridWall(map, x, y)? wallTile : floorTile, cell, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        }
+    }
+}
+
+// Draw chunk cells tiles into chunk render texture
+static void DrawMazeLayerChunkTiles(MazeLayer layer, MazeGrid map, MazeLayerChunk* chunk)
+{
+    Point min = { chunk->chunk.x * MAZE_LAYER_CHUNK_SIZE, chunk->chunk.y * MAZE_LAYER_CHUNK_SIZE };
+    Point max = { min.x + MAZE_LAYER_CHUNK_SIZE, min.y + MAZE_LAYER_CHUNK_SIZE };
+
+    BeginTextureMode(chunk->target);
+    ClearBackground(BLANK);
+    DrawMazeLayerTiles(layer, map, min, max, (Vector2){ 0, 0 });
+    EndTextureMode();
+
+    chunk->dirty = false;
+}
+
+// Load layer for a map of given size
+// NOTE: A view not aligned with chunks covers one more chunk on every axis
+MazeLayer LoadMazeLayer(int width, int height, float cellSize, Texture2D tileset, Vector2 maxViewSize)
+{
+    MazeLayer layer = { 0 };
+
+    layer.width = width;
+    layer.height = height;
+    layer.cellSize = cellSize;
+    layer.tileset = tileset;
+
+    float chunkSize = MAZE_LAYER_CHUNK_SIZE * cellSize;
+    int chunksX = (width + MAZE_LAYER_CHUNK_SIZE - 1) / MAZE_LAYER_CHUNK_SIZE;
+    int chunksY = (height + MAZE_LAYER_CHUNK_SIZE - 1) / MAZE_LAYER_CHUNK_SIZE;
+    int viewChunksX = (int)(maxViewSize.x / chunkSize) + 2;
+    int viewChunksY = (int)(maxViewSize.y / chunkSize) + 2;
+
+    layer.maxChunks = ((viewChunksX < chunksX)? viewChunksX : chunksX) * ((viewChunksY < chunksY)? viewChunksY : chunksY);
+    layer.chunks = (MazeLayerChunk*)malloc(layer.maxChunks * sizeof(MazeLayerChunk));
+    if (layer.chunks == NULL) layer.maxChunks = 0;
+
+    return layer;
+}
+
+// Unload layer chunks render textures
+void UnloadMazeLayer(MazeLayer layer)
+{
+    for (int i = 0; i < layer.chunkCount; i++) UnloadRenderTexture(layer.chunks[i].target);
+
+    free(layer.chunks);
+}
+
+// Set tiles texture, all chunks drawn again
+void SetMazeLayerTileset(MazeLayer* layer, Texture2D tileset)
+{
+    layer->tileset = tileset;
+
+    for (int i = 0; i < layer->chunkCount; i++) layer->chunks[i].dirty = true;
+}
+
+// Set cell chunk to be drawn again
+void SetMazeLayerCellDirty(MazeLayer* layer, Point cell)
+{
+    MazeLayerChunk* chunk = FindMazeLayerChunk(layer, (Point){ cell.x / MAZE_LAYER_CHUNK_SIZE, cell.y / MAZE_LAYER_CHUNK_SIZE });
+
+    if (chunk != NULL) chunk->dirty = true;
+}
+
+// Draw dirty or new visible chunks tiles
+// NOTE: If more chunks are visible than max chunks loaded (i.e. bigger view), chunks array grows
+void UpdateMazeLayer(MazeLayer* layer, MazeGrid map, Vector2 position, Rectangle view)
+{
+    Point min = { 0 };
+    Point max = { 0 };
+    GetMazeLayerViewChunks(*layer, position, view, &min, &max);
+
+    layer->updateCount++;
+
+    for (int y = min.y; y <= max.y; y++)
+    {
+        for (int x = min.x; x <= max.x; x++)
+        {
+            MazeLayerChunk* chunk = FindMazeLayerChunk(layer, (Point){ x, y });
+
+            if (chunk == NULL)
+            {
+                // Least recently used chunk reused once max chunks are loaded, only if not visible on this update
+                if (layer->chunkCount >= layer->maxChunks)
+                {
+                    for (int i = 0; i < layer->chunkCount; i++)
+                    {
+                        if ((layer->chunks[i].lastUsed != layer->updateCount) && ((chunk == NULL) || (layer->chunks[i].lastUsed < chunk->lastUsed))) chunk = &layer->chunks[i];
+                    }
+                }
+
+                if (chunk == NULL)
+                {
+                    if (layer->chunkCount == layer->maxChunks)
+                    {
+                        int capacity = (layer->maxChunks > 0)? 2 * layer->maxChunks : 16;
+                        MazeLayerChunk* chunks = (MazeLayerChunk*)realloc(layer->chunks, capacity * sizeof(MazeLayerChunk));
+                        if (chunks == NULL) continue;
+
+                        layer->chunks = chunks;
+                        layer->maxChunks = capacity;
+                    }
+
+                    // New chunk render texture
+                    chunk = &layer->chunks[layer->chunkCount];
+                    chunk->target = LoadRenderTexture((int)(MAZE_LAYER_CHUNK_SIZE * layer->cellSize), (int)(MAZE_LAYER_CHUNK_SIZE * layer->cellSize));
+                    layer->chunkCount++;
+                }
+
+                chunk->chunk = (Point){ x, y };
+                chunk->dirty = true;
+            }
+
+            chunk->lastUsed = layer->updateCount;
+
+            if (chunk->dirty) DrawMazeLayerChunkTiles(*layer, map, chunk);
+        }
+    }
+}
+
+// Draw visible chunks
+// NOTE: Render textures are flipped vertically, edge chunks only draw their cells area
+// NOTE: Visible chunks are cached by UpdateMazeLayer(), chunks not cached or dirty (not updated) are not drawn
+void DrawMazeLayer(MazeLayer layer, Vector2 position, Rectangle view)
+{
+    Point minChunk = { 0 };
+    Point maxChunk = { 0 };
+    GetMazeLayerViewChunks(layer, position, view, &minChunk, &maxChunk);
+
+    for (int y = minChunk.y; y <= maxChunk.y; y++)
+    {
+        for (int x = minChunk.x; x <= maxChunk.x; x++)
+        {
+            MazeLayerChunk* chunk = FindMazeLayerChunk(&layer, (Point){ x, y });
+            Vector2 chunkPosition = { position.x + x * MAZE_LAYER_CHUNK_SIZE * layer.cellSize, position.y + y * MAZE_LAYER_CHUNK_SIZE * layer.cellSize };
+
+            if ((chunk == NULL) || chunk->dirty) continue;
+
+            int cellsX = layer.width - x * MAZE_LAYER_CHUNK_SIZE;
+            int cellsY = layer.height - y * MAZE_LAYER_CHUNK_SIZE;
+            if (cellsX > MAZE_LAYER_CHUNK_SIZE) cellsX = MAZE_LAYER_CHUNK_SIZE;
+            if (cellsY > MAZE_LAYER_CHUNK_SIZE) cellsY = MAZE_LAYER_CHUNK_SIZE;
+
+            float width = cellsX * layer.cellSize;
+            float height = cellsY * layer.cellSize;
+            Rectangle source = { 0, chunk->target.texture.height - height, width, -height };
+
+            DrawTextureRec(chunk->target.texture, source, chunkPosition, WHITE);
+        }
+    }
+}
+
+#endif // MAZE_LAYER_IMPLEMENTATION
@@ -0,0 +1,551 @@
+/*******************************************************************************************
+*
+*   maze_mesh - Chunked 3d model for maze grids, cubicmap style
+*
+*   Maze 3d model is split in chunks of MAZE_MESH_CHUNK_SIZE x MAZE_MESH_CHUNK_SIZE cells,
+*   one mesh per chunk, all meshes sharing one material (biome texture atlas).
+*   Chunks are generated and uploaded when drawn (visible), only MAZE_MESH_MAX_CHUNKS meshes
+*   are kept loaded, least recently drawn ones are unloaded, so big mazes only keep visible
+*   chunks in VRAM. Map edits only set touched loaded chunks as dirty, they are generated
+*   again when drawn, full maze mesh is never generated again for a single cell edit.
+*   Chunk meshes generation only uses CPU, it can run on worker threads: LoadMazeModelFromMeshes()
+*   uploads already generated meshes (i.e. new maze built in background).
+*
+*   Meshes follow GenMeshCubicmap() layout: cells centered on integer coordinates (x, z),
+*   walls are 1.0f height cubes (top and sides facing walkable cells), walkable cells have
+*   floor and ceiling. Texture atlas is also the same as GenMeshCubicmap() one:
+*       Sides: (0.0f, 0.0f) and (0.5f, 0.0f), Wall top and ceiling: (0.0f, 0.5f), Floor: (0.5f, 0.5f)
+*
+*   Faces not visible from walkable cells are not generated (wall bottoms, sides between
+*   walls and map borders), quads are indexed (4 vertex per face instead of 6).
+*
+*   Co-planar adjacent faces are merged in bigger quads (greedy meshing, inside every chunk):
+*   wall tops, floors and ceilings in rectangles, wall sides in runs along corridors.
+*   Merged quads repeat their atlas tile once per cell with the model shader: texcoords store
+*   the cell position on the quad (0.0f to cells count), texcoords2 the atlas tile origin.
+*
+*   NOTE: Model shader is GLSL 330 (OpenGL 3.3), atlas texture must not use mipmaps,
+*   tiles repetition (fract) breaks mipmap level selection on tiles borders.
+*
+*   CONFIGURATION:
+*       #define MAZE_MESH_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Map cells walkability
+*
+********************************************************************************************/
+
+#ifndef MAZE_MESH_H
+#define MAZE_MESH_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsMazeGridWall()
+
+#ifndef MAZE_MESH_CHUNK_SIZE
+    #define MAZE_MESH_CHUNK_SIZE    32      // Chunk width and height, in cells (max 5 faces per cell, 16 bit indices)
+#endif
+#ifndef MAZE_MESH_MAX_CHUNKS
+    #define MAZE_MESH_MAX_CHUNKS    256     // Max chunk meshes loaded, exceeded only while more chunks are drawn at once
+#endif
+
+// Maze chunked 3d model
+typedef struct MazeModel
+{
+    Model model;                // Chunk meshes model, one mesh per chunk (y*chunksX + x), one material
+    int width;                  // Map width in cells
+    int height;                 // Map height in cells
+    int chunksX;                // Chunks count on X axis
+    int chunksY;                // Chunks count on Y axis
+    bool* chunkLoaded;          // Chunk mesh generated and uploaded
+    bool* chunkDirty;           // Loaded chunk must be generated again when drawn (map edited)
+    unsigned int* chunkUsed;    // Last update chunk was drawn, least recently drawn chunks are unloaded
+    int* loadedChunks;          // Loaded chunks, chunk indices
+    int loadedCount;            // Loaded chunks count
+    unsigned int updateCount;   // Updates counter, chunks use time
+    int* chunkFaces;            // Chunks faces without merging, one face per cell side
+    int vertexCount;            // Loaded chunks vertex count, merged quads
+    int triangleCount;          // Loaded chunks triangle count, merged quads
+    int cellVertexCount;        // Loaded chunks vertex count without merging (4 vertex per face)
+    int cellTriangleCount;      // Loaded chunks triangle count without merging (2 triangles per face)
+} MazeModel;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+Mesh GenMeshMazeChunk(MazeGrid map, int chunkX, int chunkY);            // Generate chunk mesh data, not uploaded to GPU
+MazeModel LoadMazeModel(MazeGrid map);                                  // Load maze model and shader, chunks generated when first drawn
+MazeModel LoadMazeModelFromMeshes(MazeGrid map, Mesh* chunkMeshes);     // Load maze model from chunk meshes generated with GenMeshMazeChunk() (i.e. on a worker thread), meshes uploaded and owned by model
+void UnloadMazeModel(MazeModel model);                                  // Unload maze model chunk meshes, shader and data (material textures not unloaded)
+void SetMazeModelCellDirty(MazeModel* model, Point cell);               // Set loaded chunks touched by a cell edit to be generated again
+int UpdateMazeModel(MazeModel* model, MazeGrid map, const int* chunks, int chunkCount);   // Generate and upload listed chunks not loaded or dirty (i.e. visible ones), returns chunks updated
+void DrawMazeModelChunks(MazeModel model, Vector3 position, const int* chunks, int chunkCount);    // Draw only listed chunks (i.e. visible ones), chunk indices
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_MESH_H
+
+/***********************************************************************************
+*
+*   MAZE_MESH IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_MESH_IMPLEMENTATION) && !defined(MAZE_MESH_IMPLEMENTATION_DONE)
+#define MAZE_MESH_IMPLEMENTATION_DONE
+
+// Mesh faces texture atlas tiles origin, same as GenMeshCubicmap(), tiles size is 0.5f
+static const Vector2 mazeMeshSideFrontUV = { 0.0f, 0.0f };     // Right and front sides
+static const Vector2 mazeMeshSideBackUV = { 0.5f, 0.0f };      // Left and back sides
+static const Vector2 mazeMeshTopUV = { 0.0f, 0.5f };           // Wall top and ceiling
+static const Vector2 mazeMeshFloorUV = { 0.5f, 0.5f };         // Floor
+
+// Maze model shader, atlas tile repeated once per cell on merged quads
+// NOTE: Same attributes and uniforms names than raylib default shader
+static const char* mazeMeshVertexShader =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec2 vertexTexCoord2;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec2 fragTileOrigin;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragTileOrigin = vertexTexCoord2;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char* mazeMeshFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec2 fragTileOrigin;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTileOrigin + fract(fragTexCoord)*0.5)*colDiffuse;\n"
+    "}\n";
+
+// Add quad face to mesh, corners counter-clockwise seen from normal side starting at texture top-left
+// NOTE: Atlas tile repeated size.x times from a to d, size.y times from a to b
+static void AddMazeMeshQuad(Mesh* mesh, Vector3 a, Vector3 b, Vector3 c, Vector3 d, Vector3 normal, Vector2 size, Vector2 tile)
+{
+    Vector3 corners[4] = { a, b, c, d };
+    Vector2 texcoords[4] = { { 0.0f, 0.0f }, { 0.0f, size.y }, { size.x, size.y }, { size.x, 0.0f } };
+    int base = mesh->vertexCount;
+
+    for (int i = 0; i < 4; i++)
+    {
+        mesh->vertices[(base + i)*3 + 0] = corners[i].x;
+        mesh->vertices[(base + i)*3 + 1] = corners[i].y;
+        mesh->vertices[(base + i)*3 + 2] = corners[i].z;
+        mesh->normals[(base + i)*3 + 0] = normal.x;
+        mesh->normals[(base + i)*3 + 1] = normal.y;
+        mesh->normals[(base + i)*3 + 2] = normal.z;
+        mesh->texcoords[(base + i)*2 + 0] = texcoords[i].x;
+        mesh->texcoords[(base + i)*2 + 1] = texcoords[i].y;
+        mesh->texcoords2[(base + i)*2 + 0] = tile.x;
+        mesh->texcoords2[(base + i)*2 + 1] = tile.y;
+    }
+
+    unsigned short* indices = &mesh->indices[mesh->triangleCount*3];
+    indices[0] = (unsigned short)base;
+    indices[1] = (unsigned short)(base + 1);
+    indices[2] = (unsigned short)(base + 2);
+    indices[3] = (unsigned short)base;
+    indices[4] = (unsigned short)(base + 2);
+    indices[5] = (unsigned short)(base + 3);
+
+    mesh->vertexCount += 4;
+    mesh->triangleCount += 2;
+}
+
+// Get walls of map row cells [x, x + count) as bits, out-of-bounds cells are walls
+static uint64_t GetMazeMeshRowWalls(MazeGrid map, int x, int y, int count)
+{
+    uint64_t walls = 0;
+
+    for (int i = 0; i < count; i++) walls |= (uint64_t)IsMazeGridWall(map, x + i, y) << i;
+
+    return walls;
+}
+
+// Get chunk faces count without merging, one face per cell side
+static int GetMazeMeshChunkFaces(MazeGrid map, int chunkX, int chunkY)
+{
+    int startX = chunkX * MAZE_MESH_CHUNK_SIZE;
+    int startY = chunkY * MAZE_MESH_CHUNK_SIZE;
+    int endX = (startX + MAZE_MESH_CHUNK_SIZE < map.width)? startX + MAZE_MESH_CHUNK_SIZE : map.width;
+    int endY = (startY + MAZE_MESH_CHUNK_SIZE < map.height)? startY + MAZE_MESH_CHUNK_SIZE : map.height;
+    int faceCount = 0;
+
+    for (int y = startY; y < endY; y++)
+    {
+        for (int x = startX; x < endX; x++)
+        {
+            // Walkable cells: floor and ceiling, walls: top and sides facing walkable cells
+            if (!IsMazeGridWall(map, x, y)) faceCount += 2;
+            else faceCount += 1 + !IsMazeGridWall(map, x, y + 1) + !IsMazeGridWall(map, x, y - 1) + !IsMazeGridWall(map, x + 1, y) + !IsMazeGridWall(map, x - 1, y);
+        }
+    }
+
+    return faceCount;
+}
+
+// Add merged quads for rectangles of chunk cells set on rows masks, masks are cleared
+// NOTE: Greedy merge, runs on a row grow down while next rows have the same run
+// NOTE: Faces: 0-Wall top, 1-Floor, 2-Ceiling
+static void AddMazeMeshRects(Mesh* mesh, uint64_t* masks, int rows, int startX, int startY, int face)
+{
+    for (int r = 0; r < rows; r++)
+    {
+        while (masks[r] != 0)
+        {
+            int x = GetMazeGridLowestBit(masks[r]);
+            int length = GetMazeGridLowestBit(~(masks[r] >> x));
+            uint64_t run = ((length == 64)? ~0ULL : ((1ULL << length) - 1)) << x;
+            int height = 1;
+
+            masks[r] &= ~run;
+            while ((r + height < rows) && ((masks[r + height] & run) == run))
+            {
+                masks[r + height] &= ~run;
+                height++;
+            }
+
+            float x0 = startX + x - 0.5f;
+            float x1 = x0 + length;
+            float z0 = startY + r - 0.5f;
+            float z1 = z0 + height;
+
+            if (face == 0) AddMazeMeshQuad(mesh, (Vector3){ x0, 1.0f, z0 }, (Vector3){ x0, 1.0f, z1 }, (Vector3){ x1, 1.0f, z1 }, (Vector3){ x1, 1.0f, z0 }, (Vector3){ 0.0f, 1.0f, 0.0f }, (Vector2){ (float)length, (float)height }, mazeMeshTopUV);
+            else if (face == 1) AddMazeMeshQuad(mesh, (Vector3){ x0, 0.0f, z0 }, (Vector3){ x0, 0.0f, z1 }, (Vector3){ x1, 0.0f, z1 }, (Vector3){ x1, 0.0f, z0 }, (Vector3){ 0.0f, 1.0f, 0.0f }, (Vector2){ (float)length, (float)height }, mazeMeshFloorUV);
+            else AddMazeMeshQuad(mesh, (Vector3){ x0, 1.0f, z0 }, (Vector3){ x1, 1.0f, z0 }, (Vector3){ x1, 1.0f, z1 }, (Vector3){ x0, 1.0f, z1 }, (Vector3){ 0.0f, -1.0f, 0.0f }, (Vector2){ (float)height, (float)length }, mazeMeshTopUV);
+        }
+    }
+}
+
+// Generate chunk mesh data
+// NOTE: Vertex positions in map coordinates, all chunks are drawn with the same transform
+// NOTE: Mesh data allocated with RL_MALLOC(), same as raylib meshes, freed by UnloadMesh()
+Mesh GenMeshMazeChunk(MazeGrid map, int chunkX, int chunkY)
+{
+    Mesh mesh = { 0 };
+
+    int startX = chunkX * MAZE_MESH_CHUNK_SIZE;
+    int startY = chunkY * MAZE_MESH_CHUNK_SIZE;
+    int cols = (startX + MAZE_MESH_CHUNK_SIZE < map.width)? MAZE_MESH_CHUNK_SIZE : map.width - startX;
+    int rows = (startY + MAZE_MESH_CHUNK_SIZE < map.height)? MAZE_MESH_CHUNK_SIZE : map.height - startY;
+
+    // Unmerged faces count, mesh data allocated for it and shrinked once merged
+    int maxFaces = GetMazeMeshChunkFaces(map, chunkX, chunkY);
+    if (maxFaces == 0) return mesh;
+
+    mesh.vertices = (float*)RL_MALLOC(maxFaces * 4 * 3 * sizeof(float));
+    mesh.normals = (float*)RL_MALLOC(maxFaces * 4 * 3 * sizeof(float));
+    mesh.texcoords = (float*)RL_MALLOC(maxFaces * 4 * 2 * sizeof(float));
+    mesh.texcoords2 = (float*)RL_MALLOC(maxFaces * 4 * 2 * sizeof(float));
+    mesh.indices = (unsigned short*)RL_MALLOC(maxFaces * 6 * sizeof(unsigned short));
+
+    // Chunk rows walls with one cell border: bit 0 is cell (startX - 1), rows 0 and (rows + 1) are outside chunk
+    uint64_t rowWalls[MAZE_MESH_CHUNK_SIZE + 2] = { 0 };
+    uint64_t colsMask = (cols == 64)? ~0ULL : ((1ULL << cols) - 1);
+
+    for (int r = 0; r < rows + 2; r++) rowWalls[r] = GetMazeMeshRowWalls(map, startX - 1, startY + r - 1, cols + 2);
+
+    uint64_t walls[MAZE_MESH_CHUNK_SIZE] = { 0 };
+    uint64_t floors[MAZE_MESH_CHUNK_SIZE] = { 0 };
+    uint64_t ceilings[MAZE_MESH_CHUNK_SIZE] = { 0 };
+    uint64_t front[MAZE_MESH_CHUNK_SIZE] = { 0 };
+    uint64_t back[MAZE_MESH_CHUNK_SIZE] = { 0 };
+    uint64_t right[MAZE_MESH_CHUNK_SIZE] = { 0 };
+    uint64_t left[MAZE_MESH_CHUNK_SIZE] = { 0 };
+
+    for (int r = 0; r < rows; r++)
+    {
+        walls[r] = (rowWalls[r + 1] >> 1) & colsMask;
+        floors[r] = ~walls[r] & colsMask;
+        ceilings[r] = floors[r];
+        front[r] = walls[r] & ~(rowWalls[r + 2] >> 1);    // Walkable cell below (+Z)
+        back[r] = walls[r] & ~(rowWalls[r] >> 1);         // Walkable cell above (-Z)
+        right[r] = walls[r] & ~(rowWalls[r + 1] >> 2);    // Walkable cell right (+X)
+        left[r] = walls[r] & ~rowWalls[r + 1];            // Walkable cell left (-X)
+    }
+
+    // Wall tops, floors and ceilings: rectangles
+    AddMazeMeshRects(&mesh, walls, rows, startX, startY, 0);
+    AddMazeMeshRects(&mesh, floors, rows, startX, startY, 1);
+    AddMazeMeshRects(&mesh, ceilings, rows, startX, startY, 2);
+
+    // Front and back sides: runs along X on every row
+    for (int r = 0; r < rows; r++)
+    {
+        for (int side = 0; side < 2; side++)
+        {
+            uint64_t mask = (side == 0)? front[r] : back[r];
+
+            while (mask != 0)
+            {
+                int x = GetMazeGridLowestBit(mask);
+                int length = GetMazeGridLowestBit(~(mask >> x));
+                mask &= ~(((length == 64)? ~0ULL : ((1ULL << length) - 1)) << x);
+
+                float x0 = startX + x - 0.5f;
+                float x1 = x0 + length;
+
+                if (side == 0)
+                {
+                    float z = startY + r + 0.5f;
+                    AddMazeMeshQuad(&mesh, (Vector3){ x0, 1.0f, z }, (Vector3){ x0, 0.0f, z }, (Vector3){ x1, 0.0f, z }, (Vector3){ x1, 1.0f, z }, (Vector3){ 0.0f, 0.0f, 1.0f }, (Vector2){ (float)length, 1.0f }, mazeMeshSideFrontUV);
+                }
+                else
+                {
+                    float z = startY + r - 0.5f;
+                    AddMazeMeshQuad(&mesh, (Vector3){ x1, 1.0f, z }, (Vector3){ x1, 0.0f, z }, (Vector3){ x0, 0.0f, z }, (Vector3){ x0, 1.0f, z }, (Vector3){ 0.0f, 0.0f, -1.0f }, (Vector2){ (float)length, 1.0f }, mazeMeshSideBackUV);
+                }
+            }
+        }
+    }
+
+    // Right and left sides: runs along Z on every column
+    for (int c = 0; c < cols; c++)
+    {
+        for (int side = 0; side < 2; side++)
+        {
+            uint64_t* masks = (side == 0)? right : left;
+
+            for (int r = 0; r < rows; r++)
+            {
+                if (!((masks[r] >> c) & 1)) continue;
+
+                int length = 1;
+                while ((r + length < rows) && ((masks[r + length] >> c) & 1)) length++;
+
+                float z0 = startY + r - 0.5f;
+                float z1 = z0 + length;
+
+                if (side == 0)
+                {
+                    float x = startX + c + 0.5f;
+                    AddMazeMeshQuad(&mesh, (Vector3){ x, 1.0f, z1 }, (Vector3){ x, 0.0f, z1 }, (Vector3){ x, 0.0f, z0 }, (Vector3){ x, 1.0f, z0 }, (Vector3){ 1.0f, 0.0f, 0.0f }, (Vector2){ (float)length, 1.0f }, mazeMeshSideFrontUV);
+                }
+                else
+                {
+                    float x = startX + c - 0.5f;
+                    AddMazeMeshQuad(&mesh, (Vector3){ x, 1.0f, z0 }, (Vector3){ x, 0.0f, z0 }, (Vector3){ x, 0.0f, z1 }, (Vector3){ x, 1.0f, z1 }, (Vector3){ -1.0f, 0.0f, 0.0f }, (Vector2){ (float)length, 1.0f }, mazeMeshSideBackUV);
+                }
+
+                r += length - 1;
+            }
+        }
+    }
+
+    // Mesh data shrinked to merged quads
+    mesh.vertices = (float*)RL_REALLOC(mesh.vertices, mesh.vertexCount * 3 * sizeof(float));
+    mesh.normals = (float*)RL_REALLOC(mesh.normals, mesh.vertexCount * 3 * sizeof(float));
+    mesh.texcoords = (float*)RL_REALLOC(mesh.texcoords, mesh.vertexCount * 2 * sizeof(float));
+    mesh.texcoords2 = (float*)RL_REALLOC(mesh.texcoords2, mesh.vertexCount * 2 * sizeof(float));
+    mesh.indices = (unsigned short*)RL_REALLOC(mesh.indices, mesh.triangleCount * 3 * sizeof(unsigned short));
+
+    return mesh;
+}
+
+// Set chunk mesh, previous chunk mesh unloaded and new one uploaded, CPU vertex data freed
+// NOTE: Indices are kept: DrawMesh() checks them to draw indexed
+static void SetMazeModelChunkMesh(MazeModel* model, MazeGrid map, int chunk, Mesh chunkMesh)
+{
+    Mesh* mesh = &model->model.meshes[chunk];
+
+    if (!model->chunkLoaded[chunk])
+    {
+        model->chunkLoaded[chunk] = true;
+        model->loadedChunks[model->loadedCount++] = chunk;
+    }
+
+    model->chunkDirty[chunk] = false;
+
+    model->vertexCount -= mesh->vertexCount;
+    model->triangleCount -= mesh->triangleCount;
+    model->cellVertexCount -= model->chunkFaces[chunk]*4;
+    model->cellTriangleCount -= model->chunkFaces[chunk]*2;
+
+    UnloadMesh(*mesh);
+    *mesh = chunkMesh;
+    model->chunkFaces[chunk] = GetMazeMeshChunkFaces(map, chunk % model->chunksX, chunk / model->chunksX);
+
+    model->vertexCount += mesh->vertexCount;
+    model->triangleCount += mesh->triangleCount;
+    model->cellVertexCount += model->chunkFaces[chunk]*4;
+    model->cellTriangleCount += model->chunkFaces[chunk]*2;
+
+    if (mesh->vertexCount > 0)
+    {
+        UploadMesh(mesh, false);
+
+        RL_FREE(mesh->vertices);
+        RL_FREE(mesh->normals);
+        RL_FREE(mesh->texcoords);
+        RL_FREE(mesh->texcoords2);
+        mesh->vertices = NULL;
+        mesh->normals = NULL;
+        mesh->texcoords = NULL;
+        mesh->texcoords2 = NULL;
+    }
+}
+
+// Unload chunk mesh, loaded chunks list order not kept
+static void UnloadMazeModelChunk(MazeModel* model, int index)
+{
+    int chunk = model->loadedChunks[index];
+    Mesh* mesh = &model->model.meshes[chunk];
+
+    model->vertexCount -= mesh->vertexCount;
+    model->triangleCount -= mesh->triangleCount;
+    model->cellVertexCount -= model->chunkFaces[chunk]*4;
+    model->cellTriangleCount -= model->chunkFaces[chunk]*2;
+
+    UnloadMesh(*mesh);
+    *mesh = (Mesh){ 0 };
+    model->chunkFaces[chunk] = 0;
+    model->chunkLoaded[chunk] = false;
+    model->chunkDirty[chunk] = false;
+    model->loadedChunks[index] = model->loadedChunks[--model->loadedCount];
+}
+
+// Load maze model
+// NOTE: Chunk meshes are empty until drawn, model can be loaded for any maze size
+MazeModel LoadMazeModel(MazeGrid map)
+{
+    MazeModel model = { 0 };
+
+    model.width = map.width;
+    model.height = map.height;
+    model.chunksX = (map.width + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE;
+    model.chunksY = (map.height + MAZE_MESH_CHUNK_SIZE - 1) / MAZE_MESH_CHUNK_SIZE;
+
+    int chunkCount = model.chunksX * model.chunksY;
+
+    model.model.transform = (Matrix){ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+    model.model.meshCount = chunkCount;
+    model.model.meshes = (Mesh*)RL_CALLOC(chunkCount, sizeof(Mesh));
+    model.model.meshMaterial = (int*)RL_CALLOC(chunkCount, sizeof(int));
+    model.model.materialCount = 1;
+    model.model.materials = (Material*)RL_CALLOC(1, sizeof(Material));
+    model.model.materials[0] = LoadMaterialDefault();
+    model.model.materials[0].shader = LoadShaderFromMemory(mazeMeshVertexShader, mazeMeshFragmentShader);
+
+    model.chunkLoaded = (bool*)RL_CALLOC(chunkCount, sizeof(bool));
+    model.chunkDirty = (bool*)RL_CALLOC(chunkCount, sizeof(bool));
+    model.chunkUsed = (unsigned int*)RL_CALLOC(chunkCount, sizeof(unsigned int));
+    model.loadedChunks = (int*)RL_MALLOC(chunkCount * sizeof(int));
+    model.chunkFaces = (int*)RL_CALLOC(chunkCount, sizeof(int));
+
+    return model;
+}
+
+// Load maze model from chunk meshes, one mesh per chunk (y*chunksX + x)
+// NOTE: Meshes data owned by model once loaded, chunkMeshes array is not freed,
+// chunks over max loaded chunks are unloaded on first update if not drawn
+MazeModel LoadMazeModelFromMeshes(MazeGrid map, Mesh* chunkMeshes)
+{
+    MazeModel model = LoadMazeModel(map);
+
+    for (int i = 0; i < model.chunksX * model.chunksY; i++) SetMazeModelChunkMesh(&model, map, i, chunkMeshes[i]);
+
+    return model;
+}
+
+// Unload maze model chunk meshes and data
+void UnloadMazeModel(MazeModel model)
+{
+    if (model.model.meshes == NULL) return;
+
+    // NOTE: UnloadModel() only frees materials maps, biome textures are owned by caller
+    UnloadShader(model.model.materials[0].shader);
+    UnloadModel(model.model);
+    RL_FREE(model.chunkLoaded);
+    RL_FREE(model.chunkDirty);
+    RL_FREE(model.chunkUsed);
+    RL_FREE(model.loadedChunks);
+    RL_FREE(model.chunkFaces);
+}
+
+// Set loaded chunks touched by a cell edit to be generated again
+// NOTE: Neighbour cells walls sides also change, cells on chunk borders set two or four chunks
+void SetMazeModelCellDirty(MazeModel* model, Point cell)
+{
+    for (int y = cell.y - 1; y <= cell.y + 1; y++)
+    {
+        for (int x = cell.x - 1; x <= cell.x + 1; x++)
+        {
+            if ((x < 0) || (y < 0) || (x >= model->width) || (y >= model->height)) continue;
+
+            int chunk = (y / MAZE_MESH_CHUNK_SIZE) * model->chunksX + (x / MAZE_MESH_CHUNK_SIZE);
+
+            if (model->chunkLoaded[chunk]) model->chunkDirty[chunk] = true;
+        }
+    }
+}
+
+// Generate and upload listed chunks not loaded or dirty
+// NOTE: Mesh CPU vertex data is freed once uploaded, indices are kept: DrawMesh() checks them to draw indexed
+int UpdateMazeModel(MazeModel* model, MazeGrid map, const int* chunks, int chunkCount)
+{
+    int updatedCount = 0;
+
+    model->updateCount++;
+
+    for (int i = 0; i < chunkCount; i++)
+    {
+        int chunk = chunks[i];
+        model->chunkUsed[chunk] = model->updateCount;
+
+        if (!model->chunkLoaded[chunk] || model->chunkDirty[chunk])
+        {
+            SetMazeModelChunkMesh(model, map, chunk, GenMeshMazeChunk(map, chunk % model->chunksX, chunk / model->chunksX));
+            updatedCount++;
+        }
+    }
+
+    // Least recently drawn chunks unloaded over max loaded chunks, chunks listed on this update are kept
+    while (model->loadedCount > MAZE_MESH_MAX_CHUNKS)
+    {
+        int oldest = -1;
+
+        for (int i = 0; i < model->loadedCount; i++)
+        {
+            unsigned int used = model->chunkUsed[model->loadedChunks[i]];
+
+            if ((used != model->updateCount) && ((oldest == -1) || (used < model->chunkUsed[model->loadedChunks[oldest]]))) oldest = i;
+        }
+
+        if (oldest == -1) break;
+
+        UnloadMazeModelChunk(model, oldest);
+    }
+
+    return updatedCount;
+}
+
+// Draw only listed chunks
+// NOTE: Same as DrawModel() with scale 1.0f and WHITE tint, chunks with no faces are skipped
+void DrawMazeModelChunks(MazeModel model, Vector3 position, const int* chunks, int chunkCount)
+{
+    Matrix transform = { 1.0f, 0.0f, 0.0f, position.x, 0.0f, 1.0f, 0.0f, position.y, 0.0f, 0.0f, 1.0f, position.z, 0.0f, 0.0f, 0.0f, 1.0f };
+
+    for (int i = 0; i < chunkCount; i++)
+    {
+        Mesh mesh = model.model.meshes[chunks[i]];
+
+        if (mesh.vertexCount > 0) DrawMesh(mesh, model.model.materials[0], transform);
+    }
+}
+
+#endif // MAZE_MESH_IMPLEMENTATION
@@ -0,0 +1,1309 @@
+/*******************************************************************************************
+*
+*   maze_path - Pathfinding functions for maze grids
+*
+*   Maps are maze walkability grids (maze_grid.h), 4-connected movement, unit cost per step
+*
+*   FEATURES:
+*       - A* search, one-shot path between two cells: LoadPathAStar()
+*       - Jump Point Search, same paths lengths as A* expanding far less nodes on open areas: LoadPathJPS()
+*       - Path planner (D* Lite), keeps the path between frames and repairs it
+*         incrementally when the start cell moves or map cells are edited
+*       - Hierarchical path graph (HPA*) for big maps: searches a small graph of cluster
+*         entrances first and refines it inside clusters, near-optimal paths: LoadPathHPA()
+*         Clusters are built on first use, so graph loading cost does not depend on map size
+*
+*   CONFIGURATION:
+*       #define MAZE_PATH_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Point type and map cells walkability
+*
+********************************************************************************************/
+
+#ifndef MAZE_PATH_H
+#define MAZE_PATH_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsCellWalkable()
+
+// Open set node, ordered by key1 (ties broken by lower key2)
+typedef struct PathHeapNode
+{
+    int key1;               // Primary key: A* f value, D* Lite k1
+    int key2;               // Secondary key: A* h value, D* Lite k2
+    int cell;               // Cell index (y*width + x)
+} PathHeapNode;
+
+// Open set, binary heap of cells supporting in-place key updates
+typedef struct PathHeap
+{
+    PathHeapNode* nodes;    // Heap nodes, every cell is at most once in the heap
+    int* index;             // Position of every cell in the heap, -1 when not in the heap
+    int count;              // Heap nodes count
+} PathHeap;
+
+// Path planner, shortest path kept between frames and repaired incrementally (D* Lite)
+// NOTE: Search runs backwards, from goal to start, so moving the start reuses previous search data
+typedef struct PathPlanner
+{
+    int width;              // Map width in cells
+    int height;             // Map height in cells
+    int* gValue;            // Cost from every cell to the goal
+    int* rhsValue;          // One-step lookahead cost from every cell to the goal
+    PathHeap heap;          // Locally inconsistent cells, ordered by D* Lite keys
+    Point start;            // Start cell of current search data
+    Point goal;             // Goal cell of current search data
+    int keyModifier;        // Heuristic offset accumulated on start moves (D* Lite km)
+    bool searchValid;       // Search data is initialized for current map and goal
+    bool pathValid;         // Cached path is up to date
+    Point* path;            // Cached path points, from goal to start (same order as LoadPathAStar())
+    int pathCount;          // Cached path points count
+    int pathCapacity;       // Cached path points allocated
+} PathPlanner;
+
+// Path graph cluster, its entrance nodes are a contiguous block of graph nodes
+typedef struct PathCluster
+{
+    int firstNode;          // First entrance node index in graph nodes
+    int nodeCount;          // Entrance nodes count
+    int nodeCapacity;       // Entrance nodes reserved in graph nodes block
+    int* distance;          // Steps between entrance nodes without leaving the cluster (nodeCount*nodeCount), -1 if not connected
+    bool built;             // Entrances and steps computed, clusters are built on first use
+} PathCluster;
+
+// Hierarchical path graph (HPA*), map split in square clusters connected through border entrances
+// NOTE: Searches run on the graph of entrances first, then every graph edge is refined inside its cluster
+typedef struct PathGraph
+{
+    int width;              // Map width in cells
+    int height;             // Map height in cells
+    int clusterSize;        // Cluster width and height in cells
+    int clusterCountX;      // Clusters per row
+    int clusterCountY;      // Clusters per column
+    PathCluster* clusters;  // Clusters data (clusterCountX*clusterCountY)
+    int* nodes;             // Entrance nodes cells (y*width + x), grouped by cluster
+    int nodeCount;          // Entrance nodes used, including blocks released by rebuilt clusters
+    int nodeCapacity;       // Entrance nodes allocated
+    int* localDistance;     // Cluster search workspace: steps to every cluster cell (clusterSize^2)
+    int* startDistance;     // Steps from last query start to its cluster cells (clusterSize^2)
+    int* endDistance;       // Steps from last query end to its cluster cells (clusterSize^2)
+    int* localQueue;        // Cluster search queue (clusterSize^2)
+} PathGraph;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Get shorter path between two points, implements pathfinding algorithm: A*
+// NOTE: Returned points go from end to start, memory must be freed by user
+Point* LoadPathAStar(MazeGrid map, Point start, Point end, int* pointCount);
+Point* LoadPathJPS(MazeGrid map, Point start, Point end, int* pointCount);     // Get shorter path between two points, using Jump Point Search (4-connected)
+int GetPathSearchExpandedCount(void);                               // Get nodes expanded by last LoadPathAStar()/LoadPathJPS()/LoadPathHPA() search
+void UnloadPathAStarData(void);                                     // Unload A*/JPS/HPA* search workspace, reused between searches
+
+// Path planner functions
+PathPlanner LoadPathPlanner(int width, int height);                 // Load path planner for a map of given size
+void UnloadPathPlanner(PathPlanner planner);                        // Unload path planner data
+void ResetPathPlanner(PathPlanner* planner);                        // Discard search data, required when the whole map changes
+void UpdatePathPlannerCell(PathPlanner* planner, MazeGrid map, Point cell);    // Notify a map cell has been edited, repairs affected search data
+const Point* UpdatePathPlanner(PathPlanner* planner, MazeGrid map, Point start, Point goal, int* pointCount);  // Get path from start to goal, cached if nothing changed
+
+// Hierarchical path graph functions (HPA*)
+PathGraph LoadPathGraph(MazeGrid map, int clusterSize);             // Load path graph for a map, split in clusters of clusterSize cells (min 4), clusters built on first use
+void UnloadPathGraph(PathGraph graph);                              // Unload path graph data
+void UpdatePathGraph(PathGraph* graph, MazeGrid map);               // Build all clusters not built yet, avoids building them on first searches
+void UpdatePathGraphCell(PathGraph* graph, MazeGrid map, Point cell);   // Notify a map cell has been edited, rebuilds touched clusters only
+Point* LoadPathHPA(PathGraph* graph, MazeGrid map, Point start, Point end, int* pointCount);    // Get near-optimal path between two points using path graph, memory must be freed by user
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_PATH_H
+
+/***********************************************************************************
+*
+*   MAZE_PATH IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_PATH_IMPLEMENTATION) && !defined(MAZE_PATH_IMPLEMENTATION_DONE)
+#define MAZE_PATH_IMPLEMENTATION_DONE    // Implementation generated once, header could be included again by other modules
+
+#include <stdlib.h>                     // Required for: malloc(), calloc(), realloc(), free(), abs()
+#include <limits.h>                     // Required for: INT_MAX
+
+#define PATH_COST_INFINITE  (INT_MAX/2) // Cost of unreachable cells, leaves room to add heuristic values
+
+//----------------------------------------------------------------------------------
+// Module internal functions: Open heap
+//----------------------------------------------------------------------------------
+static int ManhattanDistance(Point a, Point b)
+{
+    return abs(a.x - b.x) + abs(a.y - b.y);
+}
+
+// Check if heap node a must be popped before heap node b
+static inline bool PathHeapLess(PathHeapNode a, PathHeapNode b)
+{
+    return (a.key1 < b.key1) || ((a.key1 == b.key1) && (a.key2 < b.key2));
+}
+
+// Move heap node at index up, until heap order is restored
+static void PathHeapSiftUp(PathHeap* heap, int index)
+{
+    PathHeapNode node = heap->nodes[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (!PathHeapLess(node, heap->nodes[parent])) break;
+
+        heap->nodes[index] = heap->nodes[parent];
+        heap->index[heap->nodes[index].cell] = index;
+        index = parent;
+    }
+
+    heap->nodes[index] = node;
+    heap->index[node.cell] = index;
+}
+
+// Move heap node at index down, until heap order is restored
+static void PathHeapSiftDown(PathHeap* heap, int index)
+{
+    PathHeapNode node = heap->nodes[index];
+
+    while (true)
+    {
+        int child = 2 * index + 1;
+        if (child >= heap->count) break;
+        if ((child + 1 < heap->count) && PathHeapLess(heap->nodes[child + 1], heap->nodes[child])) child++;
+        if (!PathHeapLess(heap->nodes[child], node)) break;
+
+        heap->nodes[index] = heap->nodes[child];
+        heap->index[heap->nodes[index].cell] = index;
+        index = child;
+    }
+
+    heap->nodes[index] = node;
+    heap->index[node.cell] = index;
+}
+
+// Add a cell to the heap
+static void PathHeapPush(PathHeap* heap, PathHeapNode node)
+{
+    heap->nodes[heap->count] = node;
+    heap->count++;
+    PathHeapSiftUp(heap, heap->count - 1);
+}
+
+// Remove a cell from the heap, returns removed cell
+static int PathHeapRemove(PathHeap* heap, int cell)
+{
+    int index = heap->index[cell];
+
+    heap->index[cell] = -1;
+    heap->count--;
+
+    if (index < heap->count)
+    {
+        // Fill the hole with the last node, it could need to move in any direction
+        int movedCell = heap->nodes[heap->count].cell;
+        heap->nodes[index] = heap->nodes[heap->count];
+        PathHeapSiftDown(heap, index);
+        PathHeapSiftUp(heap, heap->index[movedCell]);
+    }
+
+    return cell;
+}
+
+// Remove the node with the lowest key from the heap, returns removed cell
+static int PathHeapPop(PathHeap* heap)
+{
+    return PathHeapRemove(heap, heap->nodes[0].cell);
+}
+
+// Update keys of a cell already in the heap
+static void PathHeapUpdate(PathHeap* heap, int cell, int key1, int key2)
+{
+    int index = heap->index[cell];
+
+    heap->nodes[index].key1 = key1;
+    heap->nodes[index].key2 = key2;
+    PathHeapSiftUp(heap, index);
+    PathHeapSiftDown(heap, heap->index[cell]);
+}
+
+//----------------------------------------------------------------------------------
+// Module functions definition: A*
+//----------------------------------------------------------------------------------
+
+// A* per-node search data, A* nodes are cells (y*width + x), JPS nodes are (cell*4 + direction)
+// NOTE: Nodes touched by a previous search are detected using the search stamp,
+// so the workspace does not need to be cleared between searches
+typedef struct PathCell
+{
+    unsigned int stamp;     // Search stamp when the node was last reached
+    int gValue;             // Cost from the start node to this node
+    int parent;             // Parent node index, -1 for the start node
+} PathCell;
+
+// A*/JPS search workspace, grown to map size on demand and reused between searches
+typedef struct PathSearch
+{
+    PathCell* cells;        // Per-node search data (capacity elements)
+    PathHeap heap;          // Open set, heap index of reached nodes is -1 once closed
+    int capacity;           // Nodes allocated
+    unsigned int stamp;     // Current search stamp
+    int expandedCount;      // Nodes expanded by last search
+} PathSearch;
+
+static PathSearch pathSearch = { 0 };
+
+// Prepare search workspace for a new search of nodeCount nodes
+static bool PathSearchBegin(PathSearch* search, int nodeCount)
+{
+    if (nodeCount > search->capacity)
+    {
+        UnloadPathAStarData();
+
+        search->cells = (PathCell*)calloc(nodeCount, sizeof(PathCell));
+        search->heap.nodes = (PathHeapNode*)malloc(nodeCount * sizeof(PathHeapNode));
+        search->heap.index = (int*)malloc(nodeCount * sizeof(int));
+
+        if ((search->cells == NULL) || (search->heap.nodes == NULL) || (search->heap.index == NULL))
+        {
+            UnloadPathAStarData();
+            return false;
+        }
+
+        search->capacity = nodeCount;
+    }
+
+    search->heap.count = 0;
+    search->expandedCount = 0;
+    search->stamp++;
+
+    // On stamp wrap-around, stale stamps could match again: clear them
+    if (search->stamp == 0)
+    {
+        for (int i = 0; i < search->capacity; i++) search->cells[i].stamp = 0;
+        search->stamp = 1;
+    }
+
+    return true;
+}
+
+// Grow search workspace during a search, keeping current search data
+static bool PathSearchGrow(PathSearch* search, int nodeCount)
+{
+    if (nodeCount <= search->capacity) return true;
+
+    int capacity = (2 * search->capacity > nodeCount)? 2 * search->capacity : nodeCount;
+
+    PathCell* cells = (PathCell*)realloc(search->cells, capacity * sizeof(PathCell));
+    if (cells != NULL) search->cells = cells;
+    PathHeapNode* nodes = (PathHeapNode*)realloc(search->heap.nodes, capacity * sizeof(PathHeapNode));
+    if (nodes != NULL) search->heap.nodes = nodes;
+    int* index = (int*)realloc(search->heap.index, capacity * sizeof(int));
+    if (index != NULL) search->heap.index = index;
+
+    if ((cells == NULL) || (nodes == NULL) || (index == NULL)) return false;
+
+    // New nodes not reached by any search
+    for (int i = search->capacity; i < capacity; i++) search->cells[i].stamp = 0;
+    search->capacity = capacity;
+
+    return true;
+}
+
+// Get shorter path between two points, implements pathfinding algorithm: A*
+Point* LoadPathAStar(MazeGrid map, Point start, Point end, int* pointCount)
+{
+    Point* path = NULL;
+    int pathCounter = 0;
+
+    *pointCount = 0;
+
+    if ((start.x < 0) || (start.y < 0) || (start.x >= map.width) || (start.y >= map.height)) return NULL;
+    if (!PathSearchBegin(&pathSearch, map.width * map.height)) return NULL;
+
+    PathSearch* search = &pathSearch;
+    int startCell = start.y * map.width + start.x;
+    int endCell = -1;
+
+    // Add start node to open heap
+    search->cells[startCell] = (PathCell){ search->stamp, 0, -1 };
+    PathHeapPush(&search->heap, (PathHeapNode){ ManhattanDistance(start, end), ManhattanDistance(start, end), startCell });
+
+    // Successors offsets, same order as previous implementation: left, up, down, right
+    const Point offsets[4] = { { -1, 0 }, { 0, -1 }, { 0, 1 }, { 1, 0 } };
+
+    // Loop until the open heap is empty
+    while (search->heap.count > 0)
+    {
+        // Get the node with the lowest f value and add it to the closed set
+        int current = PathHeapPop(&search->heap);
+        Point currentPosition = { current % map.width, current / map.width };
+        search->expandedCount++;
+
+        // Check if the current node is the end node
+        if ((currentPosition.x == end.x) && (currentPosition.y == end.y))
+        {
+            endCell = current;
+            break;
+        }
+
+        int tentativeG = search->cells[current].gValue + 1;
+
+        // Generate successors of current node
+        for (int i = 0; i < 4; i++)
+        {
+            Point successorPosition = { currentPosition.x + offsets[i].x, currentPosition.y + offsets[i].y };
+            if (!IsCellWalkable(map, successorPosition.x, successorPosition.y)) continue;
+
+            int successor = successorPosition.y * map.width + successorPosition.x;
+            PathCell* cell = &search->cells[successor];
+
+            if (cell->stamp != search->stamp)
+            {
+                // Successor node not reached yet, add it to the open heap
+                int hValue = ManhattanDistance(successorPosition, end);
+
+                *cell = (PathCell){ search->stamp, tentativeG, current };
+                PathHeapPush(&search->heap, (PathHeapNode){ tentativeG + hValue, hValue, successor });
+            }
+            else if ((search->heap.index[successor] >= 0) && (tentativeG < cell->gValue))
+            {
+                // Successor node already open, but a cheaper route was found: decrease its key
+                int hValue = ManhattanDistance(successorPosition, end);
+
+                cell->gValue = tentativeG;
+                cell->parent = current;
+                PathHeapUpdate(&search->heap, successor, tentativeG + hValue, hValue);
+            }
+        }
+    }
+
+    if (endCell >= 0)
+    {
+        // Path length is known from end node cost, fill a single buffer from end to start
+        pathCounter = search->cells[endCell].gValue + 1;
+        path = (Point*)malloc(pathCounter * sizeof(Point));
+
+        int cell = endCell;
+        for (int i = 0; i < pathCounter; i++)
+        {
+            path[i] = (Point){ cell % map.width, cell / map.width };
+            cell = search->cells[cell].parent;
+        }
+    }
+
+    *pointCount = pathCounter;
+
+    return path;
+}
+
+//----------------------------------------------------------------------------------
+// Module functions definition: Jump Point Search
+//----------------------------------------------------------------------------------
+
+// JPS on a 4-connected grid uses a canonical ordering of equivalent shortest paths:
+// vertical moves go first, horizontal moves only leave the row at forced neighbours.
+// Search nodes are (cell, arrival direction), so the same cell reached from different
+// directions with the same cost keeps every successor set required for optimal paths
+// NOTE: Directions use the A* successors order: 0-Left, 1-Up, 2-Down, 3-Right
+
+// Jump horizontally from (x, y), returns jump point cell or -1 if dead end
+// NOTE: Jump point found on goal cell or when a vertical neighbour opens, blocked behind.
+// Row cells are checked 64 at a time, stop cells are walls or cells with forced neighbours
+static int JumpHorizontal(MazeGrid map, int x, int y, int dx, Point end)
+{
+    int stop = -1;      // First stop cell x coordinate, -1 if row end reached
+
+    if (dx > 0)
+    {
+        int first = x + 1;
+
+        for (int index = first >> 6; (stop < 0) && (index < map.rowWords); index++)
+        {
+            uint64_t up = GetMazeGridRowWord(map, y - 1, index);
+            uint64_t down = GetMazeGridRowWord(map, y + 1, index);
+
+            // Cells behind (x - 1), last cell of previous word carried in
+            uint64_t upBehind = (up << 1) | (GetMazeGridRowWord(map, y - 1, index - 1) >> 63);
+            uint64_t downBehind = (down << 1) | (GetMazeGridRowWord(map, y + 1, index - 1) >> 63);
+            uint64_t stops = GetMazeGridRowWord(map, y, index) | (~up & upBehind) | (~down & downBehind);
+
+            if (index == (first >> 6)) stops &= (~0ULL << (first & 63));
+            if (stops != 0) stop = 64 * index + GetMazeGridLowestBit(stops);
+        }
+    }
+    else
+    {
+        int first = x - 1;
+
+        for (int index = (first >= 0)? (first >> 6) : -1; (stop < 0) && (index >= 0); index--)
+        {
+            uint64_t up = GetMazeGridRowWord(map, y - 1, index);
+            uint64_t down = GetMazeGridRowWord(map, y + 1, index);
+
+            // Cells behind (x + 1), first cell of next word carried in
+            uint64_t upBehind = (up >> 1) | (GetMazeGridRowWord(map, y - 1, index + 1) << 63);
+            uint64_t downBehind = (down >> 1) | (GetMazeGridRowWord(map, y + 1, index + 1) << 63);
+            uint64_t stops = GetMazeGridRowWord(map, y, index) | (~up & upBehind) | (~down & downBehind);
+
+            if (index == (first >> 6)) stops &= (~0ULL >> (63 - (first & 63)));
+            if (stops != 0) stop = 64 * index + GetMazeGridHighestBit(stops);
+        }
+    }
+
+    // Goal cell before the stop cell is reached walking on walkable cells
+    if ((end.y == y) && ((end.x - x) * dx > 0) && ((stop < 0) || ((stop - end.x) * dx > 0))) return y * map.width + end.x;
+
+    if ((stop < 0) || IsMazeGridWall(map, stop, y)) return -1;
+
+    return y * map.width + stop;
+}
+
+// Jump vertically from (x, y), returns jump point cell or -1 if dead end
+// NOTE: Jump point found on goal cell or when any horizontal jump from the cell finds a jump point
+static int JumpVertical(MazeGrid map, int x, int y, int dy, Point end)
+{
+    while (true)
+    {
+        y += dy;
+
+        if (!IsCellWalkable(map, x, y)) return -1;
+        if ((x == end.x) && (y == end.y)) return y * map.width + x;
+
+        if ((JumpHorizontal(map, x, y, -1, end) >= 0) || (JumpHorizontal(map, x, y, 1, end) >= 0)) return y * map.width + x;
+    }
+}
+
+// Get shorter path between two points, using Jump Point Search
+// NOTE: Returned points include every cell, same as LoadPathAStar(), from end to start
+Point* LoadPathJPS(MazeGrid map, Point start, Point end, int* pointCount)
+{
+    Point* path = NULL;
+    int pathCounter = 0;
+
+    *pointCount = 0;
+
+    if ((start.x < 0) || (start.y < 0) || (start.x >= map.width) || (start.y >= map.height)) return NULL;
+    if (!PathSearchBegin(&pathSearch, 4 * map.width * map.height)) return NULL;
+
+    PathSearch* search = &pathSearch;
+    int startNode = 4 * (start.y * map.width + start.x);    // Start node expands all directions
+    int endNode = -1;
+
+    search->cells[startNode] = (PathCell){ search->stamp, 0, -1 };
+    PathHeapPush(&search->heap, (PathHeapNode){ ManhattanDistance(start, end), ManhattanDistance(start, end), startNode });
+
+    while (search->heap.count > 0)
+    {
+        int current = PathHeapPop(&search->heap);
+        int direction = current % 4;
+        Point currentPosition = { (current / 4) % map.width, (current / 4) / map.width };
+        search->expandedCount++;
+
+        if ((currentPosition.x == end.x) && (currentPosition.y == end.y))
+        {
+            endNode = current;
+            break;
+        }
+
+        // Get jump points reachable from current node, indexed by arrival direction
+        int jumpCells[4] = { -1, -1, -1, -1 };
+        bool isStart = (search->cells[current].parent == -1);
+
+        if (isStart || (direction == 1) || (direction == 2))
+        {
+            // Natural neighbours after a vertical move: both horizontal directions and going on vertically
+            jumpCells[0] = JumpHorizontal(map, currentPosition.x, currentPosition.y, -1, end);
+            jumpCells[3] = JumpHorizontal(map, currentPosition.x, currentPosition.y, 1, end);
+            if (isStart || (direction == 1)) jumpCells[1] = JumpVertical(map, currentPosition.x, currentPosition.y, -1, end);
+            if (isStart || (direction == 2)) jumpCells[2] = JumpVertical(map, currentPosition.x, currentPosition.y, 1, end);
+        }
+        else
+        {
+            // Natural neighbour after a horizontal move: going on horizontally
+            // Forced neighbours: vertical cells that could not be reached first from the cell behind
+            int dx = (direction == 0)? -1 : 1;
+
+            jumpCells[direction] = JumpHorizontal(map, currentPosition.x, currentPosition.y, dx, end);
+
+            if (IsCellWalkable(map, currentPosition.x, currentPosition.y - 1) && !IsCellWalkable(map, currentPosition.x - dx, currentPosition.y - 1))
+                jumpCells[1] = JumpVertical(map, currentPosition.x, currentPosition.y, -1, end);
+            if (IsCellWalkable(map, currentPosition.x, currentPosition.y + 1) && !IsCellWalkable(map, currentPosition.x - dx, currentPosition.y + 1))
+                jumpCells[2] = JumpVertical(map, currentPosition.x, currentPosition.y, 1, end);
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            if (jumpCells[i] < 0) continue;
+
+            Point successorPosition = { jumpCells[i] % map.width, jumpCells[i] / map.width };
+            int successor = 4 * jumpCells[i] + i;
+            int tentativeG = search->cells[current].gValue + ManhattanDistance(currentPosition, successorPosition);
+            int hValue = ManhattanDistance(successorPosition, end);
+            PathCell* cell = &search->cells[successor];
+
+            if (cell->stamp != search->stamp)
+            {
+                *cell = (PathCell){ search->stamp, tentativeG, current };
+                PathHeapPush(&search->heap, (PathHeapNode){ tentativeG + hValue, hValue, successor });
+            }
+            else if ((search->heap.index[successor] >= 0) && (tentativeG < cell->gValue))
+            {
+                cell->gValue = tentativeG;
+                cell->parent = current;
+                PathHeapUpdate(&search->heap, successor, tentativeG + hValue, hValue);
+            }
+        }
+    }
+
+    if (endNode >= 0)
+    {
+        // Jump points are joined by straight segments: fill every cell, from end to start
+        pathCounter = search->cells[endNode].gValue + 1;
+        path = (Point*)malloc(pathCounter * sizeof(Point));
+
+        Point position = end;
+        int count = 0;
+        path[count++] = position;
+
+        for (int node = endNode; search->cells[node].parent >= 0; node = search->cells[node].parent)
+        {
+            int parentCell = search->cells[node].parent / 4;
+            Point parentPosition = { parentCell % map.width, parentCell / map.width };
+
+            while ((position.x != parentPosition.x) || (position.y != parentPosition.y))
+            {
+                position.x += (parentPosition.x > position.x) - (parentPosition.x < position.x);
+                position.y += (parentPosition.y > position.y) - (parentPosition.y < position.y);
+                path[count++] = position;
+            }
+        }
+    }
+
+    *pointCount = pathCounter;
+
+    return path;
+}
+
+// Get nodes expanded by last search
+int GetPathSearchExpandedCount(void)
+{
+    return pathSearch.expandedCount;
+}
+
+// Unload A* search workspace
+void UnloadPathAStarData(void)
+{
+    free(pathSearch.cells);
+    free(pathSearch.heap.nodes);
+    free(pathSearch.heap.index);
+    pathSearch = (PathSearch){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Module functions definition: Path planner (D* Lite)
+//----------------------------------------------------------------------------------
+
+// Get D* Lite keys for a cell: [min(g, rhs) + h(start, cell) + km; min(g, rhs)]
+static PathHeapNode PathPlannerKey(const PathPlanner* planner, int cell)
+{
+    int minValue = (planner->gValue[cell] < planner->rhsValue[cell])? planner->gValue[cell] : planner->rhsValue[cell];
+    int key1 = PATH_COST_INFINITE;
+
+    if (minValue < PATH_COST_INFINITE)
+    {
+        Point position = { cell % planner->width, cell / planner->width };
+        key1 = minValue + ManhattanDistance(planner->start, position) + planner->keyModifier;
+    }
+
+    return (PathHeapNode){ key1, minValue, cell };
+}
+
+// Recompute cell lookahead cost from its neighbours and requeue it if inconsistent
+static void PathPlannerUpdateVertex(PathPlanner* planner, MazeGrid map, int cell)
+{
+    int x = cell % planner->width;
+    int y = cell / planner->width;
+
+    if ((x != planner->goal.x) || (y != planner->goal.y))
+    {
+        int rhsValue = PATH_COST_INFINITE;
+
+        if (IsCellWalkable(map, x, y))
+        {
+            if (IsCellWalkable(map, x - 1, y) && (planner->gValue[cell - 1] + 1 < rhsValue)) rhsValue = planner->gValue[cell - 1] + 1;
+            if (IsCellWalkable(map, x, y - 1) && (planner->gValue[cell - planner->width] + 1 < rhsValue)) rhsValue = planner->gValue[cell - planner->width] + 1;
+            if (IsCellWalkable(map, x, y + 1) && (planner->gValue[cell + planner->width] + 1 < rhsValue)) rhsValue = planner->gValue[cell + planner->width] + 1;
+            if (IsCellWalkable(map, x + 1, y) && (planner->gValue[cell + 1] + 1 < rhsValue)) rhsValue = planner->gValue[cell + 1] + 1;
+        }
+
+        planner->rhsValue[cell] = rhsValue;
+    }
+
+    bool queued = (planner->heap.index[cell] >= 0);
+
+    if (planner->gValue[cell] != planner->rhsValue[cell])
+    {
+        PathHeapNode key = PathPlannerKey(planner, cell);
+
+        if (queued) PathHeapUpdate(&planner->heap, cell, key.key1, key.key2);
+        else PathHeapPush(&planner->heap, key);
+    }
+    else if (queued) PathHeapRemove(&planner->heap, cell);
+}
+
+// Update vertex of the cell neighbours inside the map
+static void PathPlannerUpdateNeighbours(PathPlanner* planner, MazeGrid map, int cell)
+{
+    int x = cell % planner->width;
+    int y = cell / planner->width;
+
+    if (x > 0) PathPlannerUpdateVertex(planner, map, cell - 1);
+    if (y > 0) PathPlannerUpdateVertex(planner, map, cell - planner->width);
+    if (y < planner->height - 1) PathPlannerUpdateVertex(planner, map, cell + planner->width);
+    if (x < planner->width - 1) PathPlannerUpdateVertex(planner, map, cell + 1);
+}
+
+// Process inconsistent cells until start cell cost is known
+static void PathPlannerComputeShortestPath(PathPlanner* planner, MazeGrid map)
+{
+    int startCell = planner->start.y * planner->width + planner->start.x;
+
+    while (planner->heap.count > 0)
+    {
+        PathHeapNode top = planner->heap.nodes[0];
+
+        if (!PathHeapLess(top, PathPlannerKey(planner, startCell)) &&
+            (planner->rhsValue[startCell] == planner->gValue[startCell])) break;
+
+        int cell = top.cell;
+        PathHeapNode key = PathPlannerKey(planner, cell);
+
+        if (PathHeapLess(top, key))
+        {
+            // Key is outdated by start moves, requeue it
+            PathHeapUpdate(&planner->heap, cell, key.key1, key.key2);
+        }
+        else if (planner->gValue[cell] > planner->rhsValue[cell])
+        {
+            // Overconsistent: cost decreased, propagate to neighbours
+            planner->gValue[cell] = planner->rhsValue[cell];
+            PathHeapPop(&planner->heap);
+            PathPlannerUpdateNeighbours(planner, map, cell);
+        }
+        else
+        {
+            // Underconsistent: cost increased, invalidate and propagate to neighbours
+            planner->gValue[cell] = PATH_COST_INFINITE;
+            PathPlannerUpdateVertex(planner, map, cell);
+            PathPlannerUpdateNeighbours(planner, map, cell);
+        }
+    }
+}
+
+// Walk costs from start to goal, following the neighbour with lower cost
+static void PathPlannerExtractPath(PathPlanner* planner, MazeGrid map)
+{
+    int cell = planner->start.y * planner->width + planner->start.x;
+    int cost = planner->gValue[cell];
+
+    planner->pathCount = 0;
+    if (cost >= PATH_COST_INFINITE) return;
+
+    if (cost + 1 > planner->pathCapacity)
+    {
+        Point* path = (Point*)realloc(planner->path, (cost + 1) * sizeof(Point));
+        if (path == NULL) return;
+
+        planner->path = path;
+        planner->pathCapacity = cost + 1;
+    }
+
+    // Path stored from goal to start: start at the end of the buffer
+    for (int i = cost; i >= 0; i--)
+    {
+        int x = cell % planner->width;
+        int y = cell / planner->width;
+        planner->path[i] = (Point){ x, y };
+
+        if (i == 0) break;
+
+        // Same neighbours order as A*: left, up, down, right
+        int next = -1;
+        if (IsCellWalkable(map, x - 1, y) && (planner->gValue[cell - 1] == i - 1)) next = cell - 1;
+        else if (IsCellWalkable(map, x, y - 1) && (planner->gValue[cell - planner->width] == i - 1)) next = cell - planner->width;
+        else if (IsCellWalkable(map, x, y + 1) && (planner->gValue[cell + planner->width] == i - 1)) next = cell + planner->width;
+        else if (IsCellWalkable(map, x + 1, y) && (planner->gValue[cell + 1] == i - 1)) next = cell + 1;
+
+        if (next < 0) return;   // Costs inconsistent, no valid path available
+
+        cell = next;
+    }
+
+    planner->pathCount = cost + 1;
+}
+
+// Load path planner for a map of given size
+PathPlanner LoadPathPlanner(int width, int height)
+{
+    PathPlanner planner = { 0 };
+    int cellCount = width * height;
+
+    planner.width = width;
+    planner.height = height;
+    planner.gValue = (int*)malloc(cellCount * sizeof(int));
+    planner.rhsValue = (int*)malloc(cellCount * sizeof(int));
+    planner.heap.nodes = (PathHeapNode*)malloc(cellCount * sizeof(PathHeapNode));
+    planner.heap.index = (int*)malloc(cellCount * sizeof(int));
+
+    return planner;
+}
+
+// Unload path planner data
+void UnloadPathPlanner(PathPlanner planner)
+{
+    free(planner.gValue);
+    free(planner.rhsValue);
+    free(planner.heap.nodes);
+    free(planner.heap.index);
+    free(planner.path);
+}
+
+// Discard search data, next update runs a full search
+void ResetPathPlanner(PathPlanner* planner)
+{
+    planner->searchValid = false;
+    planner->pathValid = false;
+}
+
+// Notify a map cell has been edited: the cell and its neighbours change their lookahead cost
+void UpdatePathPlannerCell(PathPlanner* planner, MazeGrid map, Point cell)
+{
+    if (!planner->searchValid) return;
+    if ((cell.x < 0) || (cell.y < 0) || (cell.x >= planner->width) || (cell.y >= planner->height)) return;
+
+    int index = cell.y * planner->width + cell.x;
+
+    PathPlannerUpdateVertex(planner, map, index);
+    PathPlannerUpdateNeighbours(planner, map, index);
+
+    planner->pathValid = false;
+}
+
+// Get path from start to goal, search data is only updated if start, goal or map changed
+// NOTE: Returned points are owned by the planner, valid until next planner update
+const Point* UpdatePathPlanner(PathPlanner* planner, MazeGrid map, Point start, Point goal, int* pointCount)
+{
+    *pointCount = 0;
+
+    if ((planner->width != map.width) || (planner->height != map.height))
+    {
+        UnloadPathPlanner(*planner);
+        *planner = LoadPathPlanner(map.width, map.height);
+    }
+
+    if ((planner->gValue == NULL) || (planner->rhsValue == NULL) || (planner->heap.nodes == NULL) || (planner->heap.index == NULL)) return NULL;
+    if ((start.x < 0) || (start.y < 0) || (start.x >= map.width) || (start.y >= map.height)) return NULL;
+    if ((goal.x < 0) || (goal.y < 0) || (goal.x >= map.width) || (goal.y >= map.height)) return NULL;
+
+    if (!planner->searchValid || (goal.x != planner->goal.x) || (goal.y != planner->goal.y))
+    {
+        // Initialize search data: all cells unreachable, only goal queued
+        int cellCount = planner->width * planner->height;
+
+        for (int i = 0; i < cellCount; i++)
+        {
+            planner->gValue[i] = PATH_COST_INFINITE;
+            planner->rhsValue[i] = PATH_COST_INFINITE;
+            planner->heap.index[i] = -1;
+        }
+
+        planner->heap.count = 0;
+        planner->keyModifier = 0;
+        planner->start = start;
+        planner->goal = goal;
+
+        int goalCell = goal.y * planner->width + goal.x;
+        planner->rhsValue[goalCell] = 0;
+        PathHeapPush(&planner->heap, PathPlannerKey(planner, goalCell));
+
+        planner->searchValid = true;
+        planner->pathValid = false;
+    }
+    else if ((start.x != planner->start.x) || (start.y != planner->start.y))
+    {
+        // Start moved: queued keys remain lower bounds by adding the heuristic change
+        planner->keyModifier += ManhattanDistance(planner->start, start);
+        planner->start = start;
+        planner->pathValid = false;
+    }
+
+    if (!planner->pathValid)
+    {
+        PathPlannerComputeShortestPath(planner, map);
+        PathPlannerExtractPath(planner, map);
+        planner->pathValid = true;
+    }
+
+    *pointCount = planner->pathCount;
+
+    return planner->path;
+}
+
+//----------------------------------------------------------------------------------
+// Module functions definition: Hierarchical path graph (HPA*)
+//----------------------------------------------------------------------------------
+
+#define PATH_ENTRANCE_SPLIT     6       // Border openings this wide or wider get an entrance at each end
+
+// Cluster cells rectangle, max values excluded, last row/column clusters could be smaller
+typedef struct PathBounds
+{
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+} PathBounds;
+
+// Get cluster containing map cell
+static inline int PathGraphCluster(const PathGraph* graph, int x, int y)
+{
+    return (y / graph->clusterSize) * graph->clusterCountX + x / graph->clusterSize;
+}
+
+// Get cluster cells rectangle
+static PathBounds PathGraphBounds(const PathGraph* graph, int cluster)
+{
+    PathBounds bounds = { 0 };
+
+    bounds.minX = (cluster % graph->clusterCountX) * graph->clusterSize;
+    bounds.minY = (cluster / graph->clusterCountX) * graph->clusterSize;
+    bounds.maxX = (bounds.minX + graph->clusterSize < graph->width)? bounds.minX + graph->clusterSize : graph->width;
+    bounds.maxY = (bounds.minY + graph->clusterSize < graph->height)? bounds.minY + graph->clusterSize : graph->height;
+
+    return bounds;
+}
+
+// Get cell index inside cluster workspaces (clusterSize^2)
+static inline int PathGraphLocalCell(const PathGraph* graph, int x, int y)
+{
+    return (y % graph->clusterSize) * graph->clusterSize + x % graph->clusterSize;
+}
+
+// Breadth-first search from a cell without leaving its cluster, fills steps to every cluster cell (-1 if not reached)
+static void PathGraphLocalSearch(const PathGraph* graph, MazeGrid map, Point origin, int* distance)
+{
+    PathBounds bounds = PathGraphBounds(graph, PathGraphCluster(graph, origin.x, origin.y));
+    int size = graph->clusterSize;
+    int* queue = graph->localQueue;
+    int head = 0;
+    int tail = 0;
+
+    for (int i = 0; i < size * size; i++) distance[i] = -1;
+
+    if (!IsCellWalkable(map, origin.x, origin.y)) return;
+
+    // Queue keeps local cells, map cell is (minX + local%size, minY + local/size)
+    int originLocal = PathGraphLocalCell(graph, origin.x, origin.y);
+    distance[originLocal] = 0;
+    queue[tail++] = originLocal;
+
+    while (head < tail)
+    {
+        int local = queue[head++];
+        int x = bounds.minX + local % size;
+        int y = bounds.minY + local / size;
+        int steps = distance[local] + 1;
+
+        if ((x > bounds.minX) && (distance[local - 1] < 0) && IsCellWalkable(map, x - 1, y)) { distance[local - 1] = steps; queue[tail++] = local - 1; }
+        if ((y > bounds.minY) && (distance[local - size] < 0) && IsCellWalkable(map, x, y - 1)) { distance[local - size] = steps; queue[tail++] = local - size; }
+        if ((y + 1 < bounds.maxY) && (distance[local + size] < 0) && IsCellWalkable(map, x, y + 1)) { distance[local + size] = steps; queue[tail++] = local + size; }
+        if ((x + 1 < bounds.maxX) && (distance[local + 1] < 0) && IsCellWalkable(map, x + 1, y)) { distance[local + 1] = steps; queue[tail++] = local + 1; }
+    }
+}
+
+// Add entrances of a cluster border to cells list, returns new cells count
+// NOTE: Border cells go from first cell along step direction, across offset points to the neighbour cluster.
+// Both clusters sharing a border scan it in the same order, so they always choose the same entrances
+static int PathGraphBorderEntrances(const PathGraph* graph, MazeGrid map, Point first, Point step, Point across, int length, int* cells, int count)
+{
+    int openingStart = -1;
+
+    for (int i = 0; i <= length; i++)
+    {
+        int x = first.x + i * step.x;
+        int y = first.y + i * step.y;
+        bool open = (i < length) && IsCellWalkable(map, x, y) && IsCellWalkable(map, x + across.x, y + across.y);
+
+        if (open && (openingStart < 0)) openingStart = i;
+        else if (!open && (openingStart >= 0))
+        {
+            // Narrow openings get a centered entrance, wide openings an entrance at each end
+            int entrances[2] = { openingStart + (i - openingStart) / 2, -1 };
+            if ((i - openingStart) >= PATH_ENTRANCE_SPLIT) entrances[0] = openingStart, entrances[1] = i - 1;
+
+            for (int e = 0; (e < 2) && (entrances[e] >= 0); e++)
+            {
+                int cell = (first.y + entrances[e] * step.y) * graph->width + first.x + entrances[e] * step.x;
+                bool added = false;
+
+                // Corner cells could be an entrance of two borders
+                for (int k = 0; k < count; k++) if (cells[k] == cell) added = true;
+                if (!added) cells[count++] = cell;
+            }
+
+            openingStart = -1;
+        }
+    }
+
+    return count;
+}
+
+// Build cluster entrance nodes and steps between them
+static void PathGraphBuildCluster(PathGraph* graph, MazeGrid map, int cluster)
+{
+    PathCluster* data = &graph->clusters[cluster];
+    PathBounds bounds = PathGraphBounds(graph, cluster);
+    int width = bounds.maxX - bounds.minX;
+    int height = bounds.maxY - bounds.minY;
+    int* cells = graph->localQueue;     // Entrances fit in the queue (4*clusterSize), unused until local searches start
+    int count = 0;
+
+    if (bounds.minY > 0) count = PathGraphBorderEntrances(graph, map, (Point){ bounds.minX, bounds.minY }, (Point){ 1, 0 }, (Point){ 0, -1 }, width, cells, count);
+    if (bounds.maxY < graph->height) count = PathGraphBorderEntrances(graph, map, (Point){ bounds.minX, bounds.maxY - 1 }, (Point){ 1, 0 }, (Point){ 0, 1 }, width, cells, count);
+    if (bounds.minX > 0) count = PathGraphBorderEntrances(graph, map, (Point){ bounds.minX, bounds.minY }, (Point){ 0, 1 }, (Point){ -1, 0 }, height, cells, count);
+    if (bounds.maxX < graph->width) count = PathGraphBorderEntrances(graph, map, (Point){ bounds.maxX - 1, bounds.minY }, (Point){ 0, 1 }, (Point){ 1, 0 }, height, cells, count);
+
+    data->nodeCount = 0;
+
+    data->built = true;
+
+    if (count > data->nodeCapacity)
+    {
+        // Cluster nodes block too small: move cluster to a new block at the end of graph nodes
+        if (graph->nodeCount + count > graph->nodeCapacity)
+        {
+            int capacity = 2 * graph->nodeCapacity + count;
+            int* nodes = (int*)realloc(graph->nodes, capacity * sizeof(int));
+            if (nodes == NULL) return;
+
+            graph->nodes = nodes;
+            graph->nodeCapacity = capacity;
+        }
+
+        data->firstNode = graph->nodeCount;
+        data->nodeCapacity = count;
+        graph->nodeCount += count;
+    }
+
+    if (count == 0) return;
+
+    int* distance = (int*)realloc(data->distance, count * count * sizeof(int));
+    if (distance == NULL) return;
+
+    data->distance = distance;
+
+    for (int i = 0; i < count; i++) graph->nodes[data->firstNode + i] = cells[i];
+
+    // Steps between entrances, one local search per entrance, steps are the same both ways
+    for (int i = 0; i < count; i++)
+    {
+        distance[i * count + i] = 0;
+        if (i == count - 1) break;
+
+        Point origin = { graph->nodes[data->firstNode + i] % graph->width, graph->nodes[data->firstNode + i] / graph->width };
+        PathGraphLocalSearch(graph, map, origin, graph->localDistance);
+
+        for (int j = i + 1; j < count; j++)
+        {
+            int cell = graph->nodes[data->firstNode + j];
+            int steps = graph->localDistance[PathGraphLocalCell(graph, cell % graph->width, cell / graph->width)];
+
+            distance[i * count + j] = steps;
+            distance[j * count + i] = steps;
+        }
+    }
+
+    data->nodeCount = count;
+}
+
+// Get cluster data, building the cluster on first use
+// NOTE: Building a cluster could move graph nodes buffer
+static PathCluster* PathGraphGetCluster(PathGraph* graph, MazeGrid map, int cluster)
+{
+    if (!graph->clusters[cluster].built) PathGraphBuildCluster(graph, map, cluster);
+
+    return &graph->clusters[cluster];
+}
+
+// Open graph node or decrease its key if a cheaper route was found
+static void PathGraphRelax(PathSearch* search, int node, int parent, int gValue, int hValue)
+{
+    PathCell* cell = &search->cells[node];
+
+    if (cell->stamp != search->stamp)
+    {
+        *cell = (PathCell){ search->stamp, gValue, parent };
+        PathHeapPush(&search->heap, (PathHeapNode){ gValue + hValue, hValue, node });
+    }
+    else if ((search->heap.index[node] >= 0) && (gValue < cell->gValue))
+    {
+        cell->gValue = gValue;
+        cell->parent = parent;
+        PathHeapUpdate(&search->heap, node, gValue + hValue, hValue);
+    }
+}
+
+// Load path graph for a map, clusters are built on first use
+PathGraph LoadPathGraph(MazeGrid map, int clusterSize)
+{
+    PathGraph graph = { 0 };
+
+    if (clusterSize < 4) clusterSize = 4;
+
+    graph.width = map.width;
+    graph.height = map.height;
+    graph.clusterSize = clusterSize;
+    graph.clusterCountX = (map.width + clusterSize - 1) / clusterSize;
+    graph.clusterCountY = (map.height + clusterSize - 1) / clusterSize;
+
+    int clusterCount = graph.clusterCountX * graph.clusterCountY;
+
+    // Mazes average a few entrances per cluster, nodes are grown on demand
+    graph.nodeCapacity = 4 * clusterCount;
+    graph.clusters = (PathCluster*)calloc(clusterCount, sizeof(PathCluster));
+    graph.nodes = (int*)malloc(graph.nodeCapacity * sizeof(int));
+    graph.localDistance = (int*)malloc(clusterSize * clusterSize * sizeof(int));
+    graph.startDistance = (int*)malloc(clusterSize * clusterSize * sizeof(int));
+    graph.endDistance = (int*)malloc(clusterSize * clusterSize * sizeof(int));
+    graph.localQueue = (int*)malloc(clusterSize * clusterSize * sizeof(int));
+
+    if ((graph.clusters == NULL) || (graph.nodes == NULL) || (graph.localDistance == NULL) ||
+        (graph.startDistance == NULL) || (graph.endDistance == NULL) || (graph.localQueue == NULL))
+    {
+        UnloadPathGraph(graph);
+        return (PathGraph){ 0 };
+    }
+
+    return graph;
+}
+
+// Unload path graph data
+void UnloadPathGraph(PathGraph graph)
+{
+    if (graph.clusters != NULL)
+    {
+        for (int i = 0; i < graph.clusterCountX * graph.clusterCountY; i++) free(graph.clusters[i].distance);
+    }
+
+    free(graph.clusters);
+    free(graph.nodes);
+    free(graph.localDistance);
+    free(graph.startDistance);
+    free(graph.endDistance);
+    free(graph.localQueue);
+}
+
+// Build all clusters not built yet
+void UpdatePathGraph(PathGraph* graph, MazeGrid map)
+{
+    if (graph->clusters == NULL) return;
+
+    for (int i = 0; i < graph->clusterCountX * graph->clusterCountY; i++) PathGraphGetCluster(graph, map, i);
+}
+
+// Notify a map cell has been edited: its cluster is rebuilt, and the cluster across if the cell is on a border
+// NOTE: Clusters not built yet are skipped, map size must not change (a new map requires a new path graph)
+void UpdatePathGraphCell(PathGraph* graph, MazeGrid map, Point cell)
+{
+    if (graph->clusters == NULL) return;
+    if ((cell.x < 0) || (cell.y < 0) || (cell.x >= graph->width) || (cell.y >= graph->height)) return;
+
+    int cluster = PathGraphCluster(graph, cell.x, cell.y);
+    int localX = cell.x % graph->clusterSize;
+    int localY = cell.y % graph->clusterSize;
+    int touched[5] = { cluster, -1, -1, -1, -1 };
+
+    if ((localX == 0) && (cell.x > 0)) touched[1] = cluster - 1;
+    if ((localX == graph->clusterSize - 1) && (cell.x + 1 < graph->width)) touched[2] = cluster + 1;
+    if ((localY == 0) && (cell.y > 0)) touched[3] = cluster - graph->clusterCountX;
+    if ((localY == graph->clusterSize - 1) && (cell.y + 1 < graph->height)) touched[4] = cluster + graph->clusterCountX;
+
+    for (int i = 0; i < 5; i++)
+    {
+        if ((touched[i] >= 0) && graph->clusters[touched[i]].built) PathGraphBuildCluster(graph, map, touched[i]);
+    }
+}
+
+// Get near-optimal path between two points using path graph
+// NOTE: Start and end are connected to the entrances of their clusters for this query only,
+// returned points include every cell, same as LoadPathAStar(), from end to start
+Point* LoadPathHPA(PathGraph* graph, MazeGrid map, Point start, Point end, int* pointCount)
+{
+    Point* path = NULL;
+    int pathCounter = 0;
+
+    *pointCount = 0;
+
+    if ((graph->clusters == NULL) || (graph->width != map.width) || (graph->height != map.height)) return NULL;
+    if ((start.x < 0) || (start.y < 0) || (start.x >= map.width) || (start.y >= map.height)) return NULL;
+    if ((end.x < 0) || (end.y < 0) || (end.x >= map.width) || (end.y >= map.height)) return NULL;
+
+    // Search nodes: 0-Start, 1-End, entrance node i is search node i + 2
+    const int startNode = 0;
+    const int endNode = 1;
+    int startCell = start.y * map.width + start.x;
+    int startCluster = PathGraphCluster(graph, start.x, start.y);
+    int endCluster = PathGraphCluster(graph, end.x, end.y);
+    bool endReached = false;
+
+    PathGraphGetCluster(graph, map, startCluster);
+    PathGraphGetCluster(graph, map, endCluster);
+
+    if (!PathSearchBegin(&pathSearch, graph->nodeCount + 2)) return NULL;
+
+    PathSearch* search = &pathSearch;
+
+    PathGraphLocalSearch(graph, map, start, graph->startDistance);
+    PathGraphLocalSearch(graph, map, end, graph->endDistance);
+
+    search->cells[startNode] = (PathCell){ search->stamp, 0, -1 };
+    PathHeapPush(&search->heap, (PathHeapNode){ ManhattanDistance(start, end), ManhattanDistance(start, end), startNode });
+
+    const Point offsets[4] = { { -1, 0 }, { 0, -1 }, { 0, 1 }, { 1, 0 } };
+
+    while (search->heap.count > 0)
+    {
+        int current = PathHeapPop(&search->heap);
+        search->expandedCount++;
+
+        if (current == endNode)
+        {
+            endReached = true;
+            break;
+        }
+
+        int currentCell = (current == startNode)? startCell : graph->nodes[current - 2];
+        Point currentPosition = { currentCell % map.width, currentCell / map.width };
+        int cluster = PathGraphCluster(graph, currentPosition.x, currentPosition.y);
+        PathCluster* data = &graph->clusters[cluster];
+        int gValue = search->cells[current].gValue;
+
+        if (current == startNode)
+        {
+            // Start connects to every entrance it reaches inside its cluster
+            for (int j = 0; j < data->nodeCount; j++)
+            {
+                int cell = graph->nodes[data->firstNode + j];
+                int steps = graph->startDistance[PathGraphLocalCell(graph, cell % map.width, cell / map.width)];
+                Point position = { cell % map.width, cell / map.width };
+
+                if (steps >= 0) PathGraphRelax(search, data->firstNode + j + 2, current, gValue + steps, ManhattanDistance(position, end));
+            }
+        }
+        else
+        {
+            // Intra-cluster edges: precomputed steps to the other entrances of the cluster
+            int i = current - 2 - data->firstNode;
+
+            for (int j = 0; j < data->nodeCount; j++)
+            {
+                int steps = data->distance[i * data->nodeCount + j];
+                int cell = graph->nodes[data->firstNode + j];
+                Point position = { cell % map.width, cell / map.width };
+
+                if ((j != i) && (steps >= 0)) PathGraphRelax(search, data->firstNode + j + 2, current, gValue + steps, ManhattanDistance(position, end));
+            }
+
+            // Inter-cluster edges: entrances of the clusters across, one step away
+            for (int k = 0; k < 4; k++)
+            {
+                Point position = { currentPosition.x + offsets[k].x, currentPosition.y + offsets[k].y };
+                if (!IsCellWalkable(map, position.x, position.y)) continue;
+
+                int neighbour = PathGraphCluster(graph, position.x, position.y);
+                if (neighbour == cluster) continue;
+
+                // Clusters across could be reached for the first time, their new nodes are not in the search yet
+                PathCluster* across = PathGraphGetCluster(graph, map, neighbour);
+                if (!PathSearchGrow(search, graph->nodeCount + 2)) return NULL;
+
+                int cell = position.y * map.width + position.x;
+
+                for (int j = 0; j < across->nodeCount; j++)
+                {
+                    if (graph->nodes[across->firstNode + j] == cell) PathGraphRelax(search, across->firstNode + j + 2, current, gValue + 1, ManhattanDistance(position, end));
+                }
+            }
+        }
+
+        // End connects to every node of its cluster that reaches it
+        if (cluster == endCluster)
+        {
+            int steps = graph->endDistance[PathGraphLocalCell(graph, currentPosition.x, currentPosition.y)];
+            if (steps >= 0) PathGraphRelax(search, endNode, current, gValue + steps, 0);
+        }
+    }
+
+    if (endReached)
+    {
+        // Graph edges are refined cell by cell: neighbour cells across clusters,
+        // or walking down local search steps inside a cluster, from end to start
+        pathCounter = search->cells[endNode].gValue + 1;
+        path = (Point*)malloc(pathCounter * sizeof(Point));
+
+        Point position = end;
+        int count = 0;
+        path[count++] = position;
+
+        for (int node = endNode; search->cells[node].parent >= 0; node = search->cells[node].parent)
+        {
+            int parent = search->cells[node].parent;
+            int parentCell = (parent == startNode)? startCell : graph->nodes[parent - 2];
+            Point parentPosition = { parentCell % map.width, parentCell / map.width };
+            int cluster = PathGraphCluster(graph, parentPosition.x, parentPosition.y);
+
+            if (PathGraphCluster(graph, position.x, position.y) != cluster) path[count++] = parentPosition;
+            else
+            {
+                PathBounds bounds = PathGraphBounds(graph, cluster);
+                PathGraphLocalSearch(graph, map, parentPosition, graph->localDistance);
+
+                for (int steps = graph->localDistance[PathGraphLocalCell(graph, position.x, position.y)]; steps > 0; steps--)
+                {
+                    for (int k = 0; k < 4; k++)
+                    {
+                        Point next = { position.x + offsets[k].x, position.y + offsets[k].y };
+
+                        if ((next.x >= bounds.minX) && (next.y >= bounds.minY) && (next.x < bounds.maxX) && (next.y < bounds.maxY) &&
+                            (graph->localDistance[PathGraphLocalCell(graph, next.x, next.y)] == steps - 1))
+                        {
+                            position = next;
+                            break;
+                        }
+                    }
+
+                    path[count++] = position;
+                }
+            }
+
+            position = parentPosition;
+        }
+    }
+
+    *pointCount = pathCounter;
+
+    return path;
+}
+
+#endif // MAZE_PATH_IMPLEMENTATION
@@ -0,0 +1,183 @@
+/*******************************************************************************************
+*
+*   raylib maze path benchmark
+*
+*   Compares A* and Jump Point Search on generated mazes, across skip chances 0.0 to 1.0:
+*   nodes expanded and time per query, checking both searches return the same path lengths
+*
+*   Compares A* and hierarchical search (HPA*) on the same mazes: graph build and cell edit
+*   time, time per query and extra path length of HPA* near-optimal paths
+*
+*   No window is required, maze generation and pathfinding only use CPU grid data
+*
+*   Build (raylib installed):
+*       gcc -O2 maze_path_bench.c -o maze_path_bench -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
+*
+*   Usage:
+*       maze_path_bench [mazeSize] [mazesPerChance] [queriesPerMaze] [clusterSize]
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#define MAZE_GRID_IMPLEMENTATION
+#include "maze_grid.h"                  // Required for: MazeGrid
+#define MAZE_PATH_IMPLEMENTATION
+#include "maze_path.h"                  // Required for: LoadPathAStar(), LoadPathJPS(), LoadPathHPA()
+#define MAZE_THREAD_IMPLEMENTATION
+#include "maze_thread.h"                // Required for: MazeThread, used by tiled maze generator, GetMazeThreadTime()
+#define MAZE_GEN_IMPLEMENTATION
+#include "maze_gen.h"                   // Required for: GenMazeGrid(), GetMazeRandomWalkableCell()
+#include "maze_random.h"                // Required for: MazeRandom, GetMazeRandomValue()
+#include <stdio.h>                      // Required for: printf()
+#include <stdlib.h>                     // Required for: atoi(), free()
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int mazeSize = (argc > 1)? atoi(argv[1]) : 256;
+    int mazesPerChance = (argc > 2)? atoi(argv[2]) : 4;
+    int queriesPerMaze = (argc > 3)? atoi(argv[3]) : 32;
+    int clusterSize = (argc > 4)? atoi(argv[4]) : 16;
+
+    if ((mazeSize < 8) || (mazesPerChance < 1) || (queriesPerMaze < 1) || (clusterSize < 4))
+    {
+        printf("Usage: maze_path_bench [mazeSize >= 8] [mazesPerChance >= 1] [queriesPerMaze >= 1] [clusterSize >= 4]\n");
+        return 1;
+    }
+
+    printf("Maze %dx%d, spacing 4x4, %d mazes per skip chance, %d random queries per maze\n\n", mazeSize, mazeSize, mazesPerChance, queriesPerMaze);
+    printf("skip | A* expanded | JPS expanded | reduction | A* ms/query | JPS ms/query | speedup | mismatches\n");
+    printf("-----+-------------+--------------+-----------+-------------+--------------+---------+-----------\n");
+
+    for (int step = 0; step <= 10; step++)
+    {
+        float skipChance = step / 10.0f;
+        long long expandedAStar = 0;
+        long long expandedJPS = 0;
+        double timeAStar = 0.0;
+        double timeJPS = 0.0;
+        int mismatches = 0;
+
+        for (int m = 0; m < mazesPerChance; m++)
+        {
+            // Fixed seeds, same mazes and queries on every run
+            MazeRandom random = InitMazeRandom(67218 + step * 1000 + m);
+            MazeGrid maze = GenMazeGrid(mazeSize, mazeSize, 4, 4, skipChance, &random);
+
+            for (int q = 0; q < queriesPerMaze; q++)
+            {
+                Point start = GetMazeRandomWalkableCell(maze, &random);
+                Point end = GetMazeRandomWalkableCell(maze, &random);
+                int countAStar = 0;
+                int countJPS = 0;
+
+                double time = GetMazeThreadTime();
+                Point* path = LoadPathAStar(maze, start, end, &countAStar);
+                timeAStar += GetMazeThreadTime() - time;
+                expandedAStar += GetPathSearchExpandedCount();
+                free(path);
+
+                time = GetMazeThreadTime();
+                path = LoadPathJPS(maze, start, end, &countJPS);
+                timeJPS += GetMazeThreadTime() - time;
+                expandedJPS += GetPathSearchExpandedCount();
+                free(path);
+
+                if (countAStar != countJPS) mismatches++;
+            }
+
+            UnloadMazeGrid(maze);
+        }
+
+        int queries = mazesPerChance * queriesPerMaze;
+
+        printf(" %.1f | %11.1f | %12.1f | %8.1fx | %11.3f | %12.3f | %6.1fx | %d\n", skipChance,
+            (double)expandedAStar / queries, (double)expandedJPS / queries, (expandedJPS > 0)? (double)expandedAStar / expandedJPS : 0.0,
+            timeAStar * 1000.0 / queries, timeJPS * 1000.0 / queries, (timeJPS > 0.0)? timeAStar / timeJPS : 0.0, mismatches);
+    }
+
+    printf("\nHPA* clusters %dx%d, same mazes and queries\n\n", clusterSize, clusterSize);
+    printf("skip | build ms | edit ms | A* ms/query | HPA* ms/query | speedup | HPA* expanded | extra length | failures\n");
+    printf("-----+----------+---------+-------------+---------------+---------+---------------+--------------+---------\n");
+
+    for (int step = 0; step <= 10; step++)
+    {
+        float skipChance = step / 10.0f;
+        double timeBuild = 0.0;
+        double timeEdit = 0.0;
+        double timeAStar = 0.0;
+        double timeHPA = 0.0;
+        long long expandedHPA = 0;
+        long long lengthAStar = 0;
+        long long lengthHPA = 0;
+        int failures = 0;
+
+        for (int m = 0; m < mazesPerChance; m++)
+        {
+            MazeRandom random = InitMazeRandom(67218 + step * 1000 + m);
+            MazeGrid maze = GenMazeGrid(mazeSize, mazeSize, 4, 4, skipChance, &random);
+
+            double time = GetMazeThreadTime();
+            PathGraph graph = LoadPathGraph(maze, clusterSize);
+            UpdatePathGraph(&graph, maze);
+            timeBuild += GetMazeThreadTime() - time;
+
+            for (int q = 0; q < queriesPerMaze; q++)
+            {
+                Point start = GetMazeRandomWalkableCell(maze, &random);
+                Point end = GetMazeRandomWalkableCell(maze, &random);
+                int countAStar = 0;
+                int countHPA = 0;
+
+                time = GetMazeThreadTime();
+                Point* path = LoadPathAStar(maze, start, end, &countAStar);
+                timeAStar += GetMazeThreadTime() - time;
+                free(path);
+
+                time = GetMazeThreadTime();
+                path = LoadPathHPA(&graph, maze, start, end, &countHPA);
+                timeHPA += GetMazeThreadTime() - time;
+                expandedHPA += GetPathSearchExpandedCount();
+                free(path);
+
+                // HPA* must find a path whenever A* does, maybe a longer one
+                if ((countAStar > 0) != (countHPA > 0)) failures++;
+                else
+                {
+                    lengthAStar += countAStar;
+                    lengthHPA += countHPA;
+                }
+            }
+
+            // Editor edits: flip a cell and rebuild the clusters touching it, twice to restore the maze
+            for (int e = 0; e < queriesPerMaze; e++)
+            {
+                Point cell = { GetMazeRandomValue(&random, 1, mazeSize - 2), GetMazeRandomValue(&random, 1, mazeSize - 2) };
+                bool wall = IsMazeGridWall(maze, cell.x, cell.y);
+
+                time = GetMazeThreadTime();
+                SetMazeGridCell(&maze, cell.x, cell.y, !wall);
+                UpdatePathGraphCell(&graph, maze, cell);
+                SetMazeGridCell(&maze, cell.x, cell.y, wall);
+                UpdatePathGraphCell(&graph, maze, cell);
+                timeEdit += (GetMazeThreadTime() - time) / 2.0;
+            }
+
+            UnloadPathGraph(graph);
+            UnloadMazeGrid(maze);
+        }
+
+        int queries = mazesPerChance * queriesPerMaze;
+
+        printf(" %.1f | %8.2f | %7.4f | %11.3f | %13.3f | %6.1fx | %13.1f | %11.2f%% | %d\n", skipChance,
+            timeBuild * 1000.0 / mazesPerChance, timeEdit * 1000.0 / queries, timeAStar * 1000.0 / queries, timeHPA * 1000.0 / queries,
+            (timeHPA > 0.0)? timeAStar / timeHPA : 0.0, (double)expandedHPA / queries,
+            (lengthAStar > 0)? 100.0 * (lengthHPA - lengthAStar) / lengthAStar : 0.0, failures);
+    }
+
+    UnloadPathAStarData();
+
+    return 0;
+}
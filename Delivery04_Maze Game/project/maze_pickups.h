@@ -0,0 +1,217 @@
+/*******************************************************************************************
+*
+*   maze_pickups - Instanced 3d models for collectible items
+*
+*   Items are added to a batch every frame (position and tint), then the whole batch is
+*   drawn with one instanced draw per model mesh: per-call overhead does not grow with items
+*   count, same cost for 16 or 10000 visible items. All items share scale and rotation,
+*   same as DrawModelEx() with a rotation around Y axis.
+*
+*   Instances transforms buffer also stores instances tint: transform matrix last row is always
+*   (0, 0, 0, 1) for translation, rotation and scale, tint is stored there (m3, m7, m11, m15)
+*   and restored by the batch shader, raylib DrawMeshInstanced() is used as is.
+*
+*   NOTE: Batch shader is GLSL 330 (OpenGL 3.3), same as maze_mesh.h model shader.
+*
+*   CONFIGURATION:
+*       #define MAZE_PICKUPS_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       raylib - Model, Shader, DrawMeshInstanced()
+*
+********************************************************************************************/
+
+#ifndef MAZE_PICKUPS_H
+#define MAZE_PICKUPS_H
+
+#include "raylib.h"
+
+// Collectible items instances batch
+typedef struct PickupBatch
+{
+    Model model;                // Items model, not owned by batch
+    Shader shader;              // Instancing shader, transform and tint per instance
+    Material* materials;        // Model materials copies using batch shader, textures not owned
+    Matrix* transforms;         // Instances transforms, tint stored on last row
+    int count;                  // Instances added since last draw
+    int capacity;               // Instances transforms capacity, grows when required
+} PickupBatch;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+PickupBatch LoadPickupBatch(Model model, int capacity);                 // Load batch shader and instances data for a model
+void UnloadPickupBatch(PickupBatch batch);                              // Unload batch shader and instances data (model not unloaded)
+void AddPickupInstance(PickupBatch* batch, Vector3 position, Color tint);   // Add item instance to batch, drawn on next batch draw
+void DrawPickupBatch(PickupBatch* batch, float scale, float rotationAngle); // Draw all batch instances (one draw per mesh) and clear batch, rotation in degrees
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_PICKUPS_H
+
+/***********************************************************************************
+*
+*   MAZE_PICKUPS IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_PICKUPS_IMPLEMENTATION) && !defined(MAZE_PICKUPS_IMPLEMENTATION_DONE)
+#define MAZE_PICKUPS_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), realloc(), free()
+#include <math.h>                       // Required for: cosf(), sinf()
+
+// Batch shader, instance transform and tint from instanceTransform attribute
+// NOTE: Same attributes and uniforms names than raylib default shader, color is texel*colDiffuse*vertexColor*tint
+static const char* pickupBatchVertexShader =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec4 vertexColor;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    mat4 transform = instanceTransform;\n"
+    "    fragColor = vertexColor*vec4(transform[0].w, transform[1].w, transform[2].w, transform[3].w);\n"
+    "    transform[0].w = 0.0;\n"
+    "    transform[1].w = 0.0;\n"
+    "    transform[2].w = 0.0;\n"
+    "    transform[3].w = 1.0;\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    gl_Position = mvp*transform*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char* pickupBatchFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTexCoord)*colDiffuse*fragColor;\n"
+    "}\n";
+
+// Multiply matrices, left transform applied first (same as raymath MatrixMultiply())
+static Matrix MultiplyPickupMatrix(Matrix left, Matrix right)
+{
+    Matrix result = { 0 };
+
+    result.m0 = left.m0*right.m0 + left.m1*right.m4 + left.m2*right.m8 + left.m3*right.m12;
+    result.m1 = left.m0*right.m1 + left.m1*right.m5 + left.m2*right.m9 + left.m3*right.m13;
+    result.m2 = left.m0*right.m2 + left.m1*right.m6 + left.m2*right.m10 + left.m3*right.m14;
+    result.m3 = left.m0*right.m3 + left.m1*right.m7 + left.m2*right.m11 + left.m3*right.m15;
+    result.m4 = left.m4*right.m0 + left.m5*right.m4 + left.m6*right.m8 + left.m7*right.m12;
+    result.m5 = left.m4*right.m1 + left.m5*right.m5 + left.m6*right.m9 + left.m7*right.m13;
+    result.m6 = left.m4*right.m2 + left.m5*right.m6 + left.m6*right.m10 + left.m7*right.m14;
+    result.m7 = left.m4*right.m3 + left.m5*right.m7 + left.m6*right.m11 + left.m7*right.m15;
+    result.m8 = left.m8*right.m0 + left.m9*right.m4 + left.m10*right.m8 + left.m11*right.m12;
+    result.m9 = left.m8*right.m1 + left.m9*right.m5 + left.m10*right.m9 + left.m11*right.m13;
+    result.m10 = left.m8*right.m2 + left.m9*right.m6 + left.m10*right.m10 + left.m11*right.m14;
+    result.m11 = left.m8*right.m3 + left.m9*right.m7 + left.m10*right.m11 + left.m11*right.m15;
+    result.m12 = left.m12*right.m0 + left.m13*right.m4 + left.m14*right.m8 + left.m15*right.m12;
+    result.m13 = left.m12*right.m1 + left.m13*right.m5 + left.m14*right.m9 + left.m15*right.m13;
+    result.m14 = left.m12*right.m2 + left.m13*right.m6 + left.m14*right.m10 + left.m15*right.m14;
+    result.m15 = left.m12*right.m3 + left.m13*right.m7 + left.m14*right.m11 + left.m15*right.m15;
+
+    return result;
+}
+
+// Load batch shader and instances data for a model
+PickupBatch LoadPickupBatch(Model model, int capacity)
+{
+    PickupBatch batch = { 0 };
+
+    batch.model = model;
+    batch.shader = LoadShaderFromMemory(pickupBatchVertexShader, pickupBatchFragmentShader);
+    batch.shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(batch.shader, "instanceTransform");
+
+    batch.materials = (Material*)malloc(((model.materialCount > 0)? model.materialCount : 1) * sizeof(Material));
+
+    for (int i = 0; i < model.materialCount; i++)
+    {
+        batch.materials[i] = model.materials[i];
+        batch.materials[i].shader = batch.shader;
+    }
+
+    batch.capacity = (capacity > 0)? capacity : 1;
+    batch.transforms = (Matrix*)malloc(batch.capacity * sizeof(Matrix));
+
+    return batch;
+}
+
+// Unload batch shader and instances data
+void UnloadPickupBatch(PickupBatch batch)
+{
+    // NOTE: Materials are copies sharing model maps, only copies array is freed
+    UnloadShader(batch.shader);
+    free(batch.materials);
+    free(batch.transforms);
+}
+
+// Add item instance to batch
+void AddPickupInstance(PickupBatch* batch, Vector3 position, Color tint)
+{
+    if (batch->count == batch->capacity)
+    {
+        Matrix* transforms = (Matrix*)realloc(batch->transforms, batch->capacity * 2 * sizeof(Matrix));
+        if (transforms == NULL) return;
+
+        batch->transforms = transforms;
+        batch->capacity *= 2;
+    }
+
+    // NOTE: Only instance position stored, shared scale and rotation applied on draw
+    Matrix* transform = &batch->transforms[batch->count++];
+
+    transform->m12 = position.x;
+    transform->m13 = position.y;
+    transform->m14 = position.z;
+    transform->m3 = tint.r / 255.0f;
+    transform->m7 = tint.g / 255.0f;
+    transform->m11 = tint.b / 255.0f;
+    transform->m15 = tint.a / 255.0f;
+}
+
+// Draw all batch instances and clear batch
+// NOTE: Same transform as DrawModelEx(): model transform, then scale, rotation around Y axis and translation
+void DrawPickupBatch(PickupBatch* batch, float scale, float rotationAngle)
+{
+    if (batch->count == 0) return;
+
+    float c = cosf(rotationAngle*DEG2RAD);
+    float s = sinf(rotationAngle*DEG2RAD);
+    Matrix rotation = { c*scale, 0.0f, s*scale, 0.0f, 0.0f, scale, 0.0f, 0.0f, -s*scale, 0.0f, c*scale, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+    Matrix base = MultiplyPickupMatrix(batch->model.transform, rotation);
+
+    // Shared transform set on every instance, translation added to instance position
+    for (int i = 0; i < batch->count; i++)
+    {
+        Matrix* transform = &batch->transforms[i];
+
+        transform->m0 = base.m0; transform->m4 = base.m4; transform->m8 = base.m8;
+        transform->m1 = base.m1; transform->m5 = base.m5; transform->m9 = base.m9;
+        transform->m2 = base.m2; transform->m6 = base.m6; transform->m10 = base.m10;
+        transform->m12 += base.m12;
+        transform->m13 += base.m13;
+        transform->m14 += base.m14;
+    }
+
+    for (int i = 0; i < batch->model.meshCount; i++)
+    {
+        DrawMeshInstanced(batch->model.meshes[i], batch->materials[batch->model.meshMaterial[i]], batch->transforms, batch->count);
+    }
+
+    batch->count = 0;
+}
+
+#endif // MAZE_PICKUPS_IMPLEMENTATION
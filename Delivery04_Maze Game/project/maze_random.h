@@ -0,0 +1,95 @@
+/*******************************************************************************************
+*
+*   maze_random - Reproducible random number generator contexts (xoshiro256**)
+*
+*   Every generator state is an explicit context passed to the functions using it, no global
+*   state: the same seed always gives the same numbers, and threads use their own contexts
+*   concurrently without locking.
+*
+*   Independent streams (per tile, per thread, per system) are derived from a seed and a
+*   stream id, states are seeded through splitmix64 so close seeds or ids are not correlated.
+*
+*   All functions are static inline, no implementation define required.
+*
+********************************************************************************************/
+
+#ifndef MAZE_RANDOM_H
+#define MAZE_RANDOM_H
+
+#include <stdint.h>                     // Required for: uint64_t, uint32_t
+
+// Random generator context, xoshiro256** state
+typedef struct MazeRandom
+{
+    uint64_t state[4];
+} MazeRandom;
+
+// Get next splitmix64 value, used to seed generator states
+static inline uint64_t MazeRandomSplitMix(uint64_t* value)
+{
+    uint64_t result = (*value += 0x9E3779B97F4A7C15ULL);
+    result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    result = (result ^ (result >> 27)) * 0x94D049BB133111EBULL;
+
+    return result ^ (result >> 31);
+}
+
+// Init random generator stream from seed and stream id
+static inline MazeRandom InitMazeRandomStream(uint64_t seed, uint64_t stream)
+{
+    MazeRandom random = { 0 };
+    uint64_t value = seed ^ MazeRandomSplitMix(&stream);
+
+    for (int i = 0; i < 4; i++) random.state[i] = MazeRandomSplitMix(&value);
+
+    return random;
+}
+
+// Init random generator from seed
+static inline MazeRandom InitMazeRandom(uint64_t seed)
+{
+    return InitMazeRandomStream(seed, 0);
+}
+
+// Get next random 64-bit number
+static inline uint64_t GetMazeRandomNext(MazeRandom* random)
+{
+    uint64_t* s = random->state;
+    uint64_t result = s[1] * 5;
+    result = ((result << 7) | (result >> 57)) * 9;
+
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return result;
+}
+
+// Get random value between min and max (both included)
+// NOTE: Multiply-shift range reduction, no modulo bias worth noting for ranges under 2^32
+static inline int GetMazeRandomValue(MazeRandom* random, int min, int max)
+{
+    if (min > max)
+    {
+        int temp = min;
+        min = max;
+        max = temp;
+    }
+
+    uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+
+    return (int)((int64_t)min + (int64_t)(((GetMazeRandomNext(random) >> 32) * range) >> 32));
+}
+
+// Get random float value in [0.0f, 1.0f)
+static inline float GetMazeRandomFloat(MazeRandom* random)
+{
+    return (float)(GetMazeRandomNext(random) >> 40) / 16777216.0f;
+}
+
+#endif // MAZE_RANDOM_H
@@ -0,0 +1,720 @@
+/*******************************************************************************************
+*
+*   maze_regions - Connected regions labelling for maze grids
+*
+*   Walkable cells are grouped in connected regions (4-neighbours): cells can reach each
+*   other only if they are in the same region. Used to check that end cells can be reached
+*   from start cells after generation or edits, and to place items on reachable cells only.
+*
+*   Labelling works on runs of walkable cells (scanline): runs are read from grid words
+*   64 cells at a time, every run is joined (union-find) with the runs it touches in the
+*   previous row, found with word operations too. Time and memory depend on the number
+*   of runs, not on cells count.
+*
+*   Single cell edits update runs and regions in place: a walkable cell can only join the
+*   regions around it, a wall cell only splits its region if its walkable neighbours are not
+*   connected around it (3x3 cells ring). Possible splits are reported, the whole map must be
+*   labelled again (i.e. once edits are finished), regions are kept joined until then.
+*
+*   Map repair removes the min number of walls required to connect two cells
+*   (0-1 breadth-first search, walls cost 1 and walkable cells 0), it uses per-cell data.
+*
+*   Regions must be updated when the map changes (maze regenerated or edited).
+*
+*   CONFIGURATION:
+*       #define MAZE_REGIONS_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Map cells walkability bits
+*
+********************************************************************************************/
+
+#ifndef MAZE_REGIONS_H
+#define MAZE_REGIONS_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, GetMazeGridLowestBit()
+
+// Walkable cells run, cells start to end - 1 of a row
+typedef struct MazeRun
+{
+    int start;                  // First run cell x
+    int end;                    // Last run cell x + 1
+    int region;                 // Run region id (parent run while labelling)
+} MazeRun;
+
+// Maze connected regions, walkable cells runs labelled with their region
+typedef struct MazeRegions
+{
+    int width;                  // Map width in cells
+    int height;                 // Map height in cells
+    int* rowRuns;               // First run of every row (height + 1 values), row y runs are rowRuns[y] to rowRuns[y + 1] - 1
+    MazeRun* runs;              // Walkable cells runs, one row after another, ordered by x
+    int runCount;               // Runs count
+    int runCapacity;            // Runs allocated, grows when required
+    int* regionSizes;           // Walkable cells count of every region
+    int regionCount;            // Regions count, region ids are 0 to regionCount - 1
+    int regionCapacity;         // Region sizes allocated, grows when required
+} MazeRegions;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeRegions LoadMazeRegions(int width, int height);                 // Load regions data for a map of given size, no regions
+void UnloadMazeRegions(MazeRegions regions);                        // Unload regions data
+bool UpdateMazeRegions(MazeRegions* regions, MazeGrid map);         // Label map walkable cells connected regions, false if regions data could not be allocated (no regions)
+bool UpdateMazeRegionsCell(MazeRegions* regions, MazeGrid map, Point cell);    // Update regions after a map cell change, false if a region could be split (full update required)
+int GetMazeRegion(MazeRegions regions, Point cell);                 // Get cell region id, -1 if wall or out of map
+int GetMazeRegionSize(MazeRegions regions, int region);             // Get region walkable cells count
+bool CheckMazeCellsConnected(MazeRegions regions, Point cell1, Point cell2);   // Check if cells are walkable and in the same region
+void SetMazeGridRegion(MazeGrid* grid, MazeRegions regions, int region);      // Set grid walkable cells to region cells only, grid must have regions size
+
+// Remove min walls required to connect start and end cells, regions are updated
+// NOTE: Returns removed walls cells (memory must be freed), NULL if cells were already connected
+Point* RepairMazeRegions(MazeRegions* regions, MazeGrid* map, Point start, Point end, int* wallCount);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_REGIONS_H
+
+/***********************************************************************************
+*
+*   MAZE_REGIONS IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_REGIONS_IMPLEMENTATION) && !defined(MAZE_REGIONS_IMPLEMENTATION_DONE)
+#define MAZE_REGIONS_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), calloc(), realloc(), free()
+#include <string.h>                     // Required for: memmove()
+
+#define REGIONS_DIRECTION_SOURCE    5   // Repair search direction for source cells, 0 for not visited cells
+
+// Cell offsets for every direction
+static const Point regionsOffsets[4] = { { -1, 0 }, { 0, -1 }, { 0, 1 }, { 1, 0 } };
+
+// Reserve runs for a new row, runs array grows when required
+// NOTE: A row has (width + 1)/2 runs at most, runs are then added without checks
+static bool ReserveMazeRowRuns(MazeRegions* regions)
+{
+    int required = regions->runCount + (regions->width + 1) / 2;
+    if (required <= regions->runCapacity) return true;
+
+    int capacity = (regions->runCapacity > 0)? regions->runCapacity : 1024;
+    while (capacity < required) capacity *= 2;
+
+    MazeRun* runs = (MazeRun*)realloc(regions->runs, capacity * sizeof(MazeRun));
+    if (runs == NULL) return false;
+
+    regions->runs = runs;
+    regions->runCapacity = capacity;
+
+    return true;
+}
+
+// Find run root while labelling, path halving
+static inline int FindMazeRunRoot(MazeRun* runs, int run)
+{
+    while (runs[run].region != run)
+    {
+        runs[run].region = runs[runs[run].region].region;
+        run = runs[run].region;
+    }
+
+    return run;
+}
+
+// Load regions data for a map of given size
+MazeRegions LoadMazeRegions(int width, int height)
+{
+    MazeRegions regions = { 0 };
+
+    regions.rowRuns = (int*)calloc(height + 1, sizeof(int));
+    if (regions.rowRuns == NULL) return regions;
+
+    regions.width = width;
+    regions.height = height;
+
+    return regions;
+}
+
+// Unload regions data
+void UnloadMazeRegions(MazeRegions regions)
+{
+    free(regions.rowRuns);
+    free(regions.runs);
+    free(regions.regionSizes);
+}
+
+// Label map walkable cells connected regions
+// NOTE: Regions data is reloaded if map size changed, no regions are left if it can not be allocated
+bool UpdateMazeRegions(MazeRegions* regions, MazeGrid map)
+{
+    if ((regions->width != map.width) || (regions->height != map.height))
+    {
+        UnloadMazeRegions(*regions);
+        *regions = LoadMazeRegions(map.width, map.height);
+    }
+
+    regions->runCount = 0;
+    regions->regionCount = 0;
+    if (regions->rowRuns == NULL) return false;
+
+    for (int y = 0; y < map.height; y++)
+    {
+        if (!ReserveMazeRowRuns(regions))
+        {
+            regions->runCount = 0;
+            for (int i = 0; i <= map.height; i++) regions->rowRuns[i] = 0;
+            return false;
+        }
+
+        regions->rowRuns[y] = regions->runCount;
+        MazeRun* runs = regions->runs;
+        const uint64_t* row = map.words + (size_t)y * map.rowWords;
+        int startCount = regions->runCount;
+        int endCount = regions->runCount;
+
+        // Runs start and end cells from row words: walkable cells with a wall before or after them
+        for (int w = 0; w < map.rowWords; w++)
+        {
+            uint64_t freeBits = ~row[w];
+            uint64_t freeBefore = (freeBits << 1) | ((w > 0)? (~row[w - 1] >> 63) : 0);
+            uint64_t freeAfter = (freeBits >> 1) | ((w + 1 < map.rowWords)? (~row[w + 1] << 63) : 0);
+            uint64_t starts = freeBits & ~freeBefore;
+            uint64_t ends = freeBits & ~freeAfter;
+
+            for (; starts != 0; starts &= starts - 1)
+            {
+                runs[startCount].start = w * 64 + GetMazeGridLowestBit(starts);
+                runs[startCount].region = startCount;
+                startCount++;
+            }
+
+            for (; ends != 0; ends &= ends - 1) runs[endCount++].end = w * 64 + GetMazeGridLowestBit(ends) + 1;
+        }
+
+        regions->runCount = startCount;
+
+        if (y == 0) continue;
+
+        // Join runs connected by cells walkable on both rows: every segment of such cells is inside
+        // one run of each row, run containing a cell is found counting the row run starts up to the cell
+        // NOTE: Lower root run index is kept as root, run parents always have a lower index
+        const uint64_t* rowAbove = row - map.rowWords;
+        int aboveBase = regions->rowRuns[y - 1] - 1;
+        int currentBase = regions->rowRuns[y] - 1;
+
+        for (int w = 0; w < map.rowWords; w++)
+        {
+            uint64_t freeAbove = ~rowAbove[w];
+            uint64_t freeCurrent = ~row[w];
+            uint64_t aboveStarts = freeAbove & ~((freeAbove << 1) | ((w > 0)? (~rowAbove[w - 1] >> 63) : 0));
+            uint64_t currentStarts = freeCurrent & ~((freeCurrent << 1) | ((w > 0)? (~row[w - 1] >> 63) : 0));
+            uint64_t both = freeAbove & freeCurrent;
+            uint64_t segments = both & ~((both << 1) | ((w > 0)? (~(rowAbove[w - 1] | row[w - 1]) >> 63) : 0));
+
+            for (; segments != 0; segments &= segments - 1)
+            {
+                uint64_t cellsUpTo = (2ULL << GetMazeGridLowestBit(segments)) - 1;
+                int root = FindMazeRunRoot(runs, aboveBase + GetMazeGridBitCount(aboveStarts & cellsUpTo));
+                int current = currentBase + GetMazeGridBitCount(currentStarts & cellsUpTo);
+
+                // Current run still its own root on first join, linked directly
+                if (runs[current].region == current) runs[current].region = root;
+                else
+                {
+                    int currentRoot = FindMazeRunRoot(runs, current);
+
+                    if (root < currentRoot) runs[currentRoot].region = root;
+                    else if (currentRoot < root) runs[root].region = currentRoot;
+                }
+            }
+
+            aboveBase += GetMazeGridBitCount(aboveStarts);
+            currentBase += GetMazeGridBitCount(currentStarts);
+        }
+    }
+
+    regions->rowRuns[map.height] = regions->runCount;
+
+    // Root runs get consecutive region ids in runs order, other runs get their parent region id:
+    // parent has a lower index, its region id is already set
+    for (int i = 0; i < regions->runCount; i++)
+    {
+        MazeRun* run = &regions->runs[i];
+
+        if (run->region == i)
+        {
+            if (regions->regionCount == regions->regionCapacity)
+            {
+                int capacity = (regions->regionCapacity > 0)? 2 * regions->regionCapacity : 256;
+                int* sizes = (int*)realloc(regions->regionSizes, capacity * sizeof(int));
+
+                if (sizes == NULL)
+                {
+                    regions->runCount = 0;
+                    regions->regionCount = 0;
+                    for (int y = 0; y <= map.height; y++) regions->rowRuns[y] = 0;
+                    return false;
+                }
+
+                regions->regionSizes = sizes;
+                regions->regionCapacity = capacity;
+            }
+
+            run->region = regions->regionCount;
+            regions->regionSizes[regions->regionCount] = 0;
+            regions->regionCount++;
+        }
+        else run->region = regions->runs[run->region].region;
+
+        regions->regionSizes[run->region] += run->end - run->start;
+    }
+
+    return true;
+}
+
+// Find last row run starting at or before x, rowRuns[y] - 1 if none
+static int FindMazeRowRun(const MazeRegions* regions, int y, int x)
+{
+    int low = regions->rowRuns[y];
+    int high = regions->rowRuns[y + 1] - 1;
+
+    while (low <= high)
+    {
+        int middle = (low + high) / 2;
+
+        if (regions->runs[middle].start <= x) low = middle + 1;
+        else high = middle - 1;
+    }
+
+    return high;
+}
+
+// Insert run in row y at runs index, following runs moved
+static bool InsertMazeRun(MazeRegions* regions, int y, int index, MazeRun run)
+{
+    if (regions->runCount == regions->runCapacity)
+    {
+        int capacity = (regions->runCapacity > 0)? 2 * regions->runCapacity : 1024;
+        MazeRun* runs = (MazeRun*)realloc(regions->runs, capacity * sizeof(MazeRun));
+        if (runs == NULL) return false;
+
+        regions->runs = runs;
+        regions->runCapacity = capacity;
+    }
+
+    memmove(&regions->runs[index + 1], &regions->runs[index], (regions->runCount - index) * sizeof(MazeRun));
+    regions->runs[index] = run;
+    regions->runCount++;
+
+    for (int i = y + 1; i <= regions->height; i++) regions->rowRuns[i]++;
+
+    return true;
+}
+
+// Remove run of row y at runs index, following runs moved
+static void RemoveMazeRun(MazeRegions* regions, int y, int index)
+{
+    memmove(&regions->runs[index], &regions->runs[index + 1], (regions->runCount - index - 1) * sizeof(MazeRun));
+    regions->runCount--;
+
+    for (int i = y + 1; i <= regions->height; i++) regions->rowRuns[i]--;
+}
+
+// Join region drop into region keep (keep < drop), last region gets drop id so region ids stay consecutive
+static void JoinMazeRegions(MazeRegions* regions, int keep, int drop)
+{
+    int last = regions->regionCount - 1;
+
+    for (int i = 0; i < regions->runCount; i++)
+    {
+        if (regions->runs[i].region == drop) regions->runs[i].region = keep;
+        else if (regions->runs[i].region == last) regions->runs[i].region = drop;
+    }
+
+    regions->regionSizes[keep] += regions->regionSizes[drop];
+    regions->regionSizes[drop] = regions->regionSizes[last];
+    regions->regionCount--;
+}
+
+// Update regions after a map cell change
+// NOTE: Runs and regions must match map before the change, map cell already changed
+bool UpdateMazeRegionsCell(MazeRegions* regions, MazeGrid map, Point cell)
+{
+    if ((regions->width != map.width) || (regions->height != map.height) || (regions->rowRuns == NULL) ||
+        (cell.x < 0) || (cell.y < 0) || (cell.x >= map.width) || (cell.y >= map.height)) return false;
+
+    int x = cell.x;
+    int y = cell.y;
+    int index = FindMazeRowRun(regions, y, x);
+    bool inRun = (index >= regions->rowRuns[y]) && (x < regions->runs[index].end);
+
+    if (!IsMazeGridWall(map, x, y))
+    {
+        if (inRun) return true;
+
+        // Regions around new walkable cell joined, lowest id kept
+        int left = ((index >= regions->rowRuns[y]) && (regions->runs[index].end == x))? index : -1;
+        int right = ((index + 1 < regions->rowRuns[y + 1]) && (regions->runs[index + 1].start == x + 1))? index + 1 : -1;
+        int around[4] = {
+            (left != -1)? regions->runs[left].region : -1, (right != -1)? regions->runs[right].region : -1,
+            GetMazeRegion(*regions, (Point){ x, y - 1 }), GetMazeRegion(*regions, (Point){ x, y + 1 })
+        };
+        int region = -1;
+
+        for (int i = 0; i < 4; i++) if ((around[i] != -1) && ((region == -1) || (around[i] < region))) region = around[i];
+
+        if (region == -1)
+        {
+            // Isolated cell, new region
+            if (regions->regionCount == regions->regionCapacity)
+            {
+                int capacity = (regions->regionCapacity > 0)? 2 * regions->regionCapacity : 256;
+                int* sizes = (int*)realloc(regions->regionSizes, capacity * sizeof(int));
+                if (sizes == NULL) return false;
+
+                regions->regionSizes = sizes;
+                regions->regionCapacity = capacity;
+            }
+
+            if (!InsertMazeRun(regions, y, index + 1, (MazeRun){ x, x + 1, regions->regionCount })) return false;
+
+            regions->regionSizes[regions->regionCount++] = 1;
+
+            return true;
+        }
+
+        // Highest id joined first, last region moved to dropped id: pending ids renamed the same way
+        for (bool joined = true; joined; )
+        {
+            int drop = -1;
+            for (int i = 0; i < 4; i++) if ((around[i] > region) && (around[i] > drop)) drop = around[i];
+
+            joined = (drop != -1);
+
+            if (joined)
+            {
+                int last = regions->regionCount - 1;
+                JoinMazeRegions(regions, region, drop);
+
+                for (int i = 0; i < 4; i++)
+                {
+                    if (around[i] == drop) around[i] = region;
+                    else if (around[i] == last) around[i] = drop;
+                }
+            }
+        }
+
+        if ((left != -1) && (right != -1))
+        {
+            regions->runs[left].end = regions->runs[right].end;
+            RemoveMazeRun(regions, y, right);
+        }
+        else if (left != -1) regions->runs[left].end++;
+        else if (right != -1) regions->runs[right].start--;
+        else if (!InsertMazeRun(regions, y, index + 1, (MazeRun){ x, x + 1, region })) return false;
+
+        regions->regionSizes[region]++;
+
+        return true;
+    }
+
+    if (!inRun) return true;
+
+    // New wall cell, region could be split if walkable neighbours are not connected around the cell:
+    // ring cells walked in order (consecutive cells are neighbours), walkable segments containing a
+    // neighbour counted, cells are connected around if there is one segment at most
+    static const Point ring[8] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 } };
+    bool walkable[8] = { 0 };
+    int first = -1;
+
+    for (int i = 0; i < 8; i++)
+    {
+        walkable[i] = IsCellWalkable(map, x + ring[i].x, y + ring[i].y);
+        if (!walkable[i] && (first == -1)) first = i;
+    }
+
+    int segmentCount = 0;
+
+    if (first != -1)
+    {
+        bool segmentNeighbour = false;
+
+        for (int k = 1; k <= 8; k++)
+        {
+            int i = (first + k) % 8;
+
+            if (walkable[i]) segmentNeighbour = segmentNeighbour || (i % 2 == 1);
+            else
+            {
+                if (segmentNeighbour) segmentCount++;
+                segmentNeighbour = false;
+            }
+        }
+    }
+
+    MazeRun* run = &regions->runs[index];
+    int region = run->region;
+
+    if (run->end - run->start == 1) RemoveMazeRun(regions, y, index);
+    else if (x == run->start) run->start++;
+    else if (x == run->end - 1) run->end--;
+    else
+    {
+        MazeRun split = { x + 1, run->end, region };
+        run->end = x;
+
+        if (!InsertMazeRun(regions, y, index + 1, split))
+        {
+            UpdateMazeRegions(regions, map);
+            return true;
+        }
+    }
+
+    regions->regionSizes[region]--;
+
+    // Empty region removed, last region moved to its id
+    // NOTE: Isolated cell region could still have cells if joined with other regions after a possible split
+    if (regions->regionSizes[region] == 0)
+    {
+        int last = regions->regionCount - 1;
+
+        for (int i = 0; i < regions->runCount; i++) if (regions->runs[i].region == last) regions->runs[i].region = region;
+
+        regions->regionSizes[region] = regions->regionSizes[last];
+        regions->regionCount--;
+    }
+
+    return (segmentCount <= 1);
+}
+
+// Get cell region id, -1 if wall or out of map
+int GetMazeRegion(MazeRegions regions, Point cell)
+{
+    if ((cell.x < 0) || (cell.y < 0) || (cell.x >= regions.width) || (cell.y >= regions.height) || (regions.rowRuns == NULL)) return -1;
+
+    // Binary search of last row run starting before cell
+    int low = regions.rowRuns[cell.y];
+    int high = regions.rowRuns[cell.y + 1] - 1;
+
+    while (low < high)
+    {
+        int middle = (low + high + 1) / 2;
+
+        if (regions.runs[middle].start <= cell.x) low = middle;
+        else high = middle - 1;
+    }
+
+    if ((low > high) || (cell.x < regions.runs[low].start) || (cell.x >= regions.runs[low].end)) return -1;
+
+    return regions.runs[low].region;
+}
+
+// Get region walkable cells count
+int GetMazeRegionSize(MazeRegions regions, int region)
+{
+    if ((region < 0) || (region >= regions.regionCount)) return 0;
+
+    return regions.regionSizes[region];
+}
+
+// Check if cells are walkable and in the same region
+bool CheckMazeCellsConnected(MazeRegions regions, Point cell1, Point cell2)
+{
+    int region = GetMazeRegion(regions, cell1);
+
+    return (region != -1) && (region == GetMazeRegion(regions, cell2));
+}
+
+// Set grid walkable cells to region cells only, all other cells are walls
+void SetMazeGridRegion(MazeGrid* grid, MazeRegions regions, int region)
+{
+    if ((grid->words == NULL) || (grid->width != regions.width) || (grid->height != regions.height)) return;
+
+    for (size_t i = 0; i < (size_t)grid->rowWords * grid->height; i++) grid->words[i] = ~0ULL;
+
+    for (int y = 0; y < regions.height; y++)
+    {
+        uint64_t* row = grid->words + (size_t)y * grid->rowWords;
+
+        for (int i = regions.rowRuns[y]; i < regions.rowRuns[y + 1]; i++)
+        {
+            if (regions.runs[i].region != region) continue;
+
+            // Run cells cleared up to 64 at a time
+            for (int x = regions.runs[i].start; x < regions.runs[i].end; )
+            {
+                int count = 64 - (x & 63);
+                if (count > regions.runs[i].end - x) count = regions.runs[i].end - x;
+
+                row[x >> 6] &= ~(((count == 64)? ~0ULL : ((1ULL << count) - 1)) << (x & 63));
+                x += count;
+            }
+        }
+    }
+}
+
+// Push cell index to a search stack, stack grows when full
+static bool PushMazeRegionsCell(int** stack, int* count, int* capacity, int cell)
+{
+    if (*count == *capacity)
+    {
+        int newCapacity = (*capacity > 0)? 2 * (*capacity) : 1024;
+        int* cells = (int*)realloc(*stack, newCapacity * sizeof(int));
+        if (cells == NULL) return false;
+
+        *stack = cells;
+        *capacity = newCapacity;
+    }
+
+    (*stack)[(*count)++] = cell;
+
+    return true;
+}
+
+// Get cell the repair search came from, cell must not be a source cell
+static inline int GetRepairParentCell(const unsigned char* direction, int width, int cell)
+{
+    Point offset = regionsOffsets[direction[cell] - 1];
+
+    return cell + offset.y * width + offset.x;
+}
+
+// Remove min walls required to connect start and end cells
+// NOTE: Search layers are cells reached with the same walls count, cells of a layer are expanded
+// in any order: walkable neighbours join current layer, wall neighbours next layer
+Point* RepairMazeRegions(MazeRegions* regions, MazeGrid* map, Point start, Point end, int* wallCount)
+{
+    *wallCount = 0;
+
+    if ((start.x < 0) || (start.y < 0) || (start.x >= map->width) || (start.y >= map->height) ||
+        (end.x < 0) || (end.y < 0) || (end.x >= map->width) || (end.y >= map->height) ||
+        ((start.x == end.x) && (start.y == end.y))) return NULL;
+
+    UpdateMazeRegions(regions, *map);
+    if (CheckMazeCellsConnected(*regions, start, end)) return NULL;
+
+    int width = map->width;
+    unsigned char* direction = (unsigned char*)calloc((size_t)width * map->height, sizeof(unsigned char));
+    int* layer = NULL;
+    int layerCount = 0;
+    int layerCapacity = 0;
+    int* nextLayer = NULL;
+    int nextLayerCount = 0;
+    int nextLayerCapacity = 0;
+    int startRegion = GetMazeRegion(*regions, start);
+    int endRegion = GetMazeRegion(*regions, end);
+    int reached = -1;
+    bool failed = (direction == NULL);
+
+    // Search sources: all start region cells, or start cell if it is a wall
+    if (startRegion == -1)
+    {
+        direction[start.y * width + start.x] = REGIONS_DIRECTION_SOURCE;
+        failed = failed || !PushMazeRegionsCell(&nextLayer, &nextLayerCount, &nextLayerCapacity, start.y * width + start.x);
+    }
+    else for (int y = 0; (y < map->height) && !failed; y++)
+    {
+        for (int i = regions->rowRuns[y]; i < regions->rowRuns[y + 1]; i++)
+        {
+            if (regions->runs[i].region != startRegion) continue;
+
+            for (int x = regions->runs[i].start; x < regions->runs[i].end; x++)
+            {
+                direction[y * width + x] = REGIONS_DIRECTION_SOURCE;
+                failed = failed || !PushMazeRegionsCell(&layer, &layerCount, &layerCapacity, y * width + x);
+            }
+        }
+    }
+
+    while (!failed && (reached == -1) && ((layerCount > 0) || (nextLayerCount > 0)))
+    {
+        // Current layer finished, next layer walls become current layer
+        if (layerCount == 0)
+        {
+            int* cells = layer;
+            int capacity = layerCapacity;
+            layer = nextLayer;
+            layerCount = nextLayerCount;
+            layerCapacity = nextLayerCapacity;
+            nextLayer = cells;
+            nextLayerCount = 0;
+            nextLayerCapacity = capacity;
+        }
+
+        int cell = layer[--layerCount];
+        int x = cell % width;
+        int y = cell / width;
+
+        for (int i = 0; (i < 4) && (reached == -1); i++)
+        {
+            Point neighbour = { x + regionsOffsets[i].x, y + regionsOffsets[i].y };
+            if ((neighbour.x < 0) || (neighbour.y < 0) || (neighbour.x >= width) || (neighbour.y >= map->height)) continue;
+
+            int index = neighbour.y * width + neighbour.x;
+            if (direction[index] != 0) continue;
+
+            direction[index] = 3 - i + 1;   // Opposite direction (back towards current cell) + 1, 0 is not visited
+
+            if (IsMazeGridWall(*map, neighbour.x, neighbour.y))
+            {
+                if ((neighbour.x == end.x) && (neighbour.y == end.y)) reached = index;
+                else failed = !PushMazeRegionsCell(&nextLayer, &nextLayerCount, &nextLayerCapacity, index);
+            }
+            else
+            {
+                if ((endRegion != -1) && (GetMazeRegion(*regions, neighbour) == endRegion)) reached = index;
+                else failed = !PushMazeRegionsCell(&layer, &layerCount, &layerCapacity, index);
+            }
+        }
+    }
+
+    Point* walls = NULL;
+
+    // Remove walls on the way back to a source cell
+    if (!failed && (reached != -1))
+    {
+        int count = 0;
+        for (int cell = reached; ; cell = GetRepairParentCell(direction, width, cell))
+        {
+            if (IsMazeGridWall(*map, cell % width, cell / width)) count++;
+            if (direction[cell] == REGIONS_DIRECTION_SOURCE) break;
+        }
+
+        walls = (Point*)malloc(count * sizeof(Point));
+
+        if (walls != NULL)
+        {
+            for (int cell = reached; ; cell = GetRepairParentCell(direction, width, cell))
+            {
+                Point point = { cell % width, cell / width };
+
+                if (IsMazeGridWall(*map, point.x, point.y))
+                {
+                    walls[(*wallCount)++] = point;
+                    SetMazeGridCell(map, point.x, point.y, false);
+                }
+
+                if (direction[cell] == REGIONS_DIRECTION_SOURCE) break;
+            }
+
+            UpdateMazeRegions(regions, *map);
+        }
+    }
+
+    free(direction);
+    free(layer);
+    free(nextLayer);
+
+    return walls;
+}
+
+#endif // MAZE_REGIONS_IMPLEMENTATION
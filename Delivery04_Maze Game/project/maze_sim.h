@@ -0,0 +1,248 @@
+/*******************************************************************************************
+*
+*   maze_sim - Maze game simulation, update logic without window or input devices
+*
+*   Game state (player, items, score and time limit) advances one step per call, with
+*   the player input given as data: the game builds it from keyboard and mouse every frame,
+*   headless tools build it from scripts or bots and run thousands of steps per second.
+*
+*   Step results (item picked up, end cell reached, time out) are returned as event flags,
+*   the caller plays sounds or collects statistics, simulation itself has no side effects.
+*
+*   Same maze, seed, inputs and step times always give the same game.
+*
+*   CONFIGURATION:
+*       #define MAZE_SIM_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*   DEPENDENCIES:
+*       maze_grid.h      - Map cells walkability
+*       maze_items.h     - Collectible items store and placement
+*       maze_collision.h - 3d player collision against walls, sliding movement
+*       maze_random.h    - Random generator contexts
+*
+********************************************************************************************/
+
+#ifndef MAZE_SIM_H
+#define MAZE_SIM_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsCellWalkable()
+#include "maze_items.h"                 // Required for: ItemStore, SetCollectibleItems()
+#include "maze_random.h"                // Required for: MazeRandom
+
+#define MAZE_SIM_TIME_LIMIT     90.0f           // Time limit to reach end cells, in seconds
+#define MAZE_SIM_ITEMS_STREAM   (1ULL << 63)    // Items random stream id, maze tiles streams use lower ids
+#define MAZE_SIM_MOVE_SPEED     5.4f            // Player 3d movement speed, in world units per second
+#define MAZE_SIM_PLAYER_RADIUS  0.1f            // Player 3d collision radius, in world units
+#define MAZE_SIM_PLAYER_HEIGHT  0.3f            // Player 3d eyes height, in world units
+
+// Simulation step events, returned as flags
+#define MAZE_SIM_EVENT_ITEM     1               // Item picked up
+#define MAZE_SIM_EVENT_WIN      2               // End cell reached, game restarted
+#define MAZE_SIM_EVENT_TIMEOUT  4               // Time limit reached, game restarted
+
+// Player input for a simulation step
+typedef struct MazeSimInput
+{
+    Point move;                 // 2d mode: cells to move on every axis (-1, 0 or 1)
+    Vector2 walk;               // 3d mode: forward and right walk direction (-1.0f to 1.0f)
+    Vector2 look;               // 3d mode: yaw and pitch view rotation, in degrees
+} MazeSimInput;
+
+// Maze game simulation state
+typedef struct MazeSim
+{
+    MazeGrid grid;              // Maze map, not owned by simulation
+    MazeGrid itemsGrid;         // Items placement cells, not owned by simulation (maze map if not set), usually cells reachable from start
+    Vector3 origin;             // 3d world position of maze cell (0, 0) center
+    Point startCells[4];        // Player start cells
+    Point endCells[4];          // End cells to reach
+    int mode;                   // Player movement mode: 0-2D (cell steps), 1-3D (first-person)
+
+    Point playerCell;           // Player current cell
+    Camera camera;              // Player 3d first-person camera, position is the player position
+    ItemStore items;            // Live collectible items, picked up items are removed
+    int itemCount;              // Items placed on every restart
+    int itemSpacing;            // Items min distance in cells (Chebyshev), 1 by default: any free cell
+    MazeRandom itemsRandom;     // Items placement random generator, new items on every restart
+    int score;                  // Collected items value
+    float remainingTime;        // Time left to reach end cells, in seconds
+    long long stepCount;        // Steps simulated since init
+} MazeSim;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeSim InitMazeSim(MazeGrid grid, MazeGrid itemsGrid, Vector3 origin, uint64_t seed, int itemCount);   // Init simulation for a maze, items placed on items grid cells (maze map if not set), same seed always places the same items
+void GetMazeSimCells(int width, int height, Point* startCells, Point* endCells);    // Get player start cells and end cells for a maze size, 4 cells each
+void UnloadMazeSim(MazeSim sim);                                                    // Unload simulation data (items store)
+void ResetMazeSim(MazeSim* sim);                                                    // Restart game: player at start cell, time limit, score and new items
+int UpdateMazeSim(MazeSim* sim, MazeSimInput input, float deltaTime);               // Update simulation one step, returns events flags
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_SIM_H
+
+/***********************************************************************************
+*
+*   MAZE_SIM IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_SIM_IMPLEMENTATION) && !defined(MAZE_SIM_IMPLEMENTATION_DONE)
+#define MAZE_SIM_IMPLEMENTATION_DONE
+
+#include "maze_collision.h"             // Required for: MoveMazeCircle(), GetMazeCellFromPosition()
+
+// Move 3d camera to player cell center, keeping view direction
+static void MazeSimSyncCamera(MazeSim* sim)
+{
+    Vector3 position = { sim->origin.x + sim->playerCell.x, sim->origin.y + MAZE_SIM_PLAYER_HEIGHT, sim->origin.z + sim->playerCell.y };
+
+    sim->camera.target.x += position.x - sim->camera.position.x;
+    sim->camera.target.y += position.y - sim->camera.position.y;
+    sim->camera.target.z += position.z - sim->camera.position.z;
+    sim->camera.position = position;
+}
+
+// Init simulation for a maze
+// NOTE: Items grid must be set on init if used, items are placed once on init
+MazeSim InitMazeSim(MazeGrid grid, MazeGrid itemsGrid, Vector3 origin, uint64_t seed, int itemCount)
+{
+    MazeSim sim = { 0 };
+
+    sim.grid = grid;
+    sim.itemsGrid = itemsGrid;
+    sim.origin = origin;
+
+    GetMazeSimCells(grid.width, grid.height, sim.startCells, sim.endCells);
+
+    sim.playerCell = sim.startCells[0];
+    sim.camera.position = (Vector3){ origin.x + sim.playerCell.x, origin.y + MAZE_SIM_PLAYER_HEIGHT, origin.z + sim.playerCell.y };
+    sim.camera.target = (Vector3){ sim.camera.position.x + 1.0f, sim.camera.position.y, sim.camera.position.z + 1.0f };
+    sim.camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    sim.camera.fovy = 45.0f;
+    sim.camera.projection = CAMERA_PERSPECTIVE;
+
+    sim.items = LoadItemStore(itemCount);
+    sim.itemCount = (itemCount < 0)? 0 : (itemCount > sim.items.capacity)? sim.items.capacity : itemCount;
+    sim.itemSpacing = 1;
+    sim.itemsRandom = InitMazeRandomStream(seed, MAZE_SIM_ITEMS_STREAM);
+
+    ResetMazeSim(&sim);
+
+    return sim;
+}
+
+// Get player start cells and end cells for a maze size
+// NOTE: Start cells on top-left corner, end cells on bottom-right corner, inside map border
+void GetMazeSimCells(int width, int height, Point* startCells, Point* endCells)
+{
+    startCells[0] = (Point){ 1, 1 };
+    startCells[1] = (Point){ 1, 2 };
+    startCells[2] = (Point){ 2, 1 };
+    startCells[3] = (Point){ 2, 2 };
+
+    endCells[0] = (Point){ width - 3, height - 3 };
+    endCells[1] = (Point){ width - 3, height - 2 };
+    endCells[2] = (Point){ width - 2, height - 3 };
+    endCells[3] = (Point){ width - 2, height - 2 };
+}
+
+// Unload simulation data
+void UnloadMazeSim(MazeSim sim)
+{
+    UnloadItemStore(sim.items);
+}
+
+// Restart game
+void ResetMazeSim(MazeSim* sim)
+{
+    sim->remainingTime = MAZE_SIM_TIME_LIMIT;
+    sim->playerCell = sim->startCells[0];
+    sim->score = 0;
+
+    MazeSimSyncCamera(sim);
+    MazeGrid itemsGrid = (sim->itemsGrid.words != NULL)? sim->itemsGrid : sim->grid;
+    SetCollectibleItems(itemsGrid, &sim->itemsRandom, sim->startCells, sim->endCells, &sim->items, sim->itemCount, sim->itemSpacing);
+}
+
+// Update simulation one step
+int UpdateMazeSim(MazeSim* sim, MazeSimInput input, float deltaTime)
+{
+    int events = 0;
+
+    if (sim->mode == 0)
+    {
+        // 2D mode: player moves cell by cell, moves into walls are cancelled
+        Point prevPlayerCell = sim->playerCell;
+        sim->playerCell.x += input.move.x;
+        sim->playerCell.y += input.move.y;
+
+        if (!IsCellWalkable(sim->grid, sim->playerCell.x, sim->playerCell.y)) sim->playerCell = prevPlayerCell;
+
+        // Keep 3d camera in sync to change mode
+        MazeSimSyncCamera(sim);
+    }
+    else
+    {
+        // 3D mode: first-person camera movement, moves into walls slide along them (view rotation is kept)
+        Vector3 prevPosition = sim->camera.position;
+        float distance = MAZE_SIM_MOVE_SPEED * deltaTime;
+
+        UpdateCameraPro(&sim->camera, (Vector3){ input.walk.x * distance, input.walk.y * distance, 0.0f }, (Vector3){ input.look.x, input.look.y, 0.0f }, 0.0f);
+
+        // Camera movement swept from previous position, only horizontal movement collides
+        Vector2 origin = { sim->origin.x, sim->origin.z };
+        Vector2 movement = { sim->camera.position.x - prevPosition.x, sim->camera.position.z - prevPosition.z };
+        Vector2 position = MoveMazeCircle(sim->grid, origin, (Vector2){ prevPosition.x, prevPosition.z }, movement, MAZE_SIM_PLAYER_RADIUS);
+
+        sim->camera.target.x += position.x - sim->camera.position.x;
+        sim->camera.target.z += position.y - sim->camera.position.z;
+        sim->camera.position.x = position.x;
+        sim->camera.position.z = position.y;
+
+        sim->playerCell = GetMazeCellFromPosition(sim->grid, origin, position);
+    }
+
+    // Items pickup, only player cell item checked
+    int item = GetCollectibleItemIndex(sim->items, sim->playerCell);
+
+    if (item != -1)
+    {
+        sim->score += sim->items.items[item].value;
+        RemoveCollectibleItem(&sim->items, item);
+        events |= MAZE_SIM_EVENT_ITEM;
+    }
+
+    // End cells reached, restart game
+    for (int i = 0; i < 4; i++)
+    {
+        if ((sim->playerCell.x == sim->endCells[i].x) && (sim->playerCell.y == sim->endCells[i].y))
+        {
+            ResetMazeSim(sim);
+            events |= MAZE_SIM_EVENT_WIN;
+            break;
+        }
+    }
+
+    // Time limit, restart game
+    sim->remainingTime -= deltaTime;
+
+    if (sim->remainingTime <= 0.0f)
+    {
+        ResetMazeSim(sim);
+        events |= MAZE_SIM_EVENT_TIMEOUT;
+    }
+
+    sim->stepCount++;
+
+    return events;
+}
+
+#endif // MAZE_SIM_IMPLEMENTATION
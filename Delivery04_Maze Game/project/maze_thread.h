@@ -0,0 +1,188 @@
+/*******************************************************************************************
+*
+*   maze_thread - Minimal portable threads for maze workers
+*
+*   Start a function on a new thread and wait for it to finish, no synchronization
+*   primitives: workers must only write data no other thread reads until joined.
+*   Threads can be checked for finished without waiting, to join them once done
+*   (i.e. background work polled every frame).
+*
+*   Win32 threads on Windows (no windows.h required, it conflicts with raylib names),
+*   POSIX threads on other platforms (link with -lpthread).
+*
+*   Wall clock time is provided to time work spread over threads: process CPU time (clock())
+*   adds the time of every thread.
+*
+*   CONFIGURATION:
+*       #define MAZE_THREAD_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+********************************************************************************************/
+
+#ifndef MAZE_THREAD_H
+#define MAZE_THREAD_H
+
+#include <stdbool.h>                    // Required for: bool
+
+// Thread function, return value is available on join
+typedef int (*MazeThreadFunc)(void* data);
+
+// Thread handle, opaque
+typedef struct MazeThread MazeThread;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeThread* LoadMazeThread(MazeThreadFunc func, void* data);       // Start function on a new thread, NULL if thread could not be created
+int UnloadMazeThread(MazeThread* thread);                           // Wait for thread to finish and unload it, returns thread function result
+bool IsMazeThreadDone(MazeThread* thread);                          // Check if thread function returned, without waiting (join required anyway)
+int GetMazeThreadCpuCount(void);                                    // Get number of logical CPU cores available (min 1)
+double GetMazeThreadTime(void);                                     // Get wall clock time in seconds (process CPU time if not available)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_THREAD_H
+
+/***********************************************************************************
+*
+*   MAZE_THREAD IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_THREAD_IMPLEMENTATION) && !defined(MAZE_THREAD_IMPLEMENTATION_DONE)
+#define MAZE_THREAD_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), free()
+#include <time.h>                       // Required for: timespec_get(), clock()
+
+#if defined(_WIN32)
+    #include <process.h>                // Required for: _beginthreadex()
+
+    // Win32 functions declared here, windows.h conflicts with raylib
+    __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void* handle, unsigned long milliseconds);
+    __declspec(dllimport) int __stdcall CloseHandle(void* handle);
+    __declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short groupNumber);
+#else
+    #include <pthread.h>                // Required for: pthread_create(), pthread_join()
+    #include <unistd.h>                 // Required for: sysconf()
+#endif
+
+struct MazeThread
+{
+#if defined(_WIN32)
+    void* handle;
+#else
+    pthread_t handle;
+#endif
+    MazeThreadFunc func;
+    void* data;
+    int result;
+    int done;                   // Function returned, only accessed atomically (POSIX)
+};
+
+// Thread entry point, runs user function
+#if defined(_WIN32)
+static unsigned __stdcall MazeThreadEntry(void* arg)
+#else
+static void* MazeThreadEntry(void* arg)
+#endif
+{
+    MazeThread* thread = (MazeThread*)arg;
+    thread->result = thread->func(thread->data);
+
+#if !defined(_WIN32)
+    __atomic_store_n(&thread->done, 1, __ATOMIC_RELEASE);
+#endif
+
+    return 0;
+}
+
+// Start function on a new thread
+MazeThread* LoadMazeThread(MazeThreadFunc func, void* data)
+{
+    MazeThread* thread = (MazeThread*)malloc(sizeof(MazeThread));
+    if (thread == NULL) return NULL;
+
+    thread->func = func;
+    thread->data = data;
+    thread->result = 0;
+    thread->done = 0;
+
+#if defined(_WIN32)
+    thread->handle = (void*)_beginthreadex(NULL, 0, MazeThreadEntry, thread, 0, NULL);
+    if (thread->handle == NULL)
+#else
+    if (pthread_create(&thread->handle, NULL, MazeThreadEntry, thread) != 0)
+#endif
+    {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+// Wait for thread to finish and unload it
+int UnloadMazeThread(MazeThread* thread)
+{
+    if (thread == NULL) return 0;
+
+#if defined(_WIN32)
+    WaitForSingleObject(thread->handle, 0xFFFFFFFF);    // INFINITE
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+
+    int result = thread->result;
+    free(thread);
+
+    return result;
+}
+
+// Check if thread function returned, without waiting
+// NOTE: Thread results must still be read after UnloadMazeThread(), join synchronizes thread memory
+bool IsMazeThreadDone(MazeThread* thread)
+{
+    if (thread == NULL) return true;
+
+#if defined(_WIN32)
+    return (WaitForSingleObject(thread->handle, 0) == 0);  // WAIT_OBJECT_0
+#else
+    return (__atomic_load_n(&thread->done, __ATOMIC_ACQUIRE) != 0);
+#endif
+}
+
+// Get number of logical CPU cores available
+int GetMazeThreadCpuCount(void)
+{
+    int count = 1;
+
+#if defined(_WIN32)
+    count = (int)GetActiveProcessorCount(0xFFFF);       // ALL_PROCESSOR_GROUPS
+#elif defined(_SC_NPROCESSORS_ONLN)
+    count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return (count > 0)? count : 1;
+}
+
+// Get wall clock time in seconds
+// NOTE: timespec_get() is C11, process CPU time used on C99 (multithreaded work time overestimated)
+double GetMazeThreadTime(void)
+{
+#if defined(TIME_UTC)
+    struct timespec time = { 0 };
+    timespec_get(&time, TIME_UTC);
+
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+#endif // MAZE_THREAD_IMPLEMENTATION
@@ -0,0 +1,250 @@
+/*******************************************************************************************
+*
+*   maze_visibility - Potentially visible cells from a first-person view on maze grids
+*
+*   Rays are cast across the maze grid (DDA, cell by cell) from the view position over the
+*   horizontal field of view, every ray stops on the first wall cell. Cells crossed by rays,
+*   and the walls stopping them, are the potentially visible set: only those cells, and the
+*   chunks containing them, must be drawn. Cost follows what the player can see, not maze size.
+*
+*   Rays are spread in angle, far cells could fall between two rays: enough rays are required
+*   for the longest corridors (i.e. one ray every 2 screen pixels). Cells around view position
+*   are always visible (camera near plane).
+*
+*   Rays stop MAZE_VISIBILITY_RANGE cells away from view position (camera far plane), so cells
+*   stamps are only kept for a window around view position: cell stamps are indexed by cell
+*   position wrapped to window size, memory does not grow with maze size (window is the map
+*   itself for maps smaller than it).
+*
+*   Maze cells are 1x1 world units squares, cell (0, 0) centered on maze origin position,
+*   same as maze_collision.h.
+*
+*   CONFIGURATION:
+*       #define MAZE_VISIBILITY_IMPLEMENTATION
+*           Generates the implementation of the module into the included file.
+*           Only one source file should define it before including this header.
+*
+*       #define MAZE_VISIBILITY_RANGE
+*           Max cells visible from view position on every axis, default 1000 cells
+*           (raylib far clip plane distance, RL_CULL_DISTANCE_FAR, one world unit per cell)
+*
+*   DEPENDENCIES:
+*       maze_grid.h  - Map cells walkability
+*
+********************************************************************************************/
+
+#ifndef MAZE_VISIBILITY_H
+#define MAZE_VISIBILITY_H
+
+#include "raylib.h"
+#include "maze_grid.h"                  // Required for: Point, MazeGrid, IsMazeGridWall()
+
+#ifndef MAZE_VISIBILITY_RANGE
+    #define MAZE_VISIBILITY_RANGE   1000    // Max cells visible from view position on every axis (camera far plane)
+#endif
+
+// Potentially visible cells and chunks, per-cell data indexed by cell wrapped to stamps window ((y%windowHeight)*windowWidth + x%windowWidth)
+typedef struct MazeVisibility
+{
+    int width;                  // Map width in cells
+    int height;                 // Map height in cells
+    int chunkSize;              // Chunk width and height in cells, same as drawn chunks
+    int chunksX;                // Chunks count on X axis
+    int chunksY;                // Chunks count on Y axis
+    int windowWidth;            // Cell stamps window width, map width if smaller than visible range
+    int windowHeight;           // Cell stamps window height
+    Point viewCell;             // View position cell on last update, visible cells are around it
+    unsigned int stamp;         // Current update stamp, cells and chunks visible on last update have it
+    unsigned int* cellStamps;   // Cells last update stamp when visible, window around view cell
+    unsigned int* chunkStamps;  // Chunks last update stamp when visible
+    Point* cells;               // Visible cells on last update
+    int cellCount;              // Visible cells count
+    int cellCapacity;           // Visible cells allocated, grows when required
+    int* chunks;                // Visible chunks on last update, chunk indices (y*chunksX + x)
+    int chunkCount;             // Visible chunks count
+} MazeVisibility;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+MazeVisibility LoadMazeVisibility(int width, int height, int chunkSize);   // Load visibility data for a map size, chunks of given size
+void UnloadMazeVisibility(MazeVisibility visibility);                   // Unload visibility data
+void UpdateMazeVisibility(MazeVisibility* visibility, MazeGrid map, Vector2 origin, Vector2 position, Vector2 direction, float fov, int rayCount);  // Cast rays over field of view (radians)
+bool IsMazeCellVisible(MazeVisibility visibility, Point cell);          // Check if cell was visible on last update
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAZE_VISIBILITY_H
+
+/***********************************************************************************
+*
+*   MAZE_VISIBILITY IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MAZE_VISIBILITY_IMPLEMENTATION) && !defined(MAZE_VISIBILITY_IMPLEMENTATION_DONE)
+#define MAZE_VISIBILITY_IMPLEMENTATION_DONE
+
+#include <stdlib.h>                     // Required for: malloc(), calloc(), realloc(), free(), abs()
+#include <string.h>                     // Required for: memset()
+#include <math.h>                       // Required for: cosf(), sinf(), atan2f(), floorf(), fabsf()
+
+// Set cell visible, cell chunk also set visible
+static void SetMazeCellVisible(MazeVisibility* visibility, int x, int y)
+{
+    if (((unsigned int)x >= (unsigned int)visibility->width) || ((unsigned int)y >= (unsigned int)visibility->height)) return;
+
+    size_t index = (size_t)(y % visibility->windowHeight) * visibility->windowWidth + (x % visibility->windowWidth);
+    if (visibility->cellStamps[index] == visibility->stamp) return;
+
+    if (visibility->cellCount == visibility->cellCapacity)
+    {
+        int capacity = (visibility->cellCapacity > 0)? 2 * visibility->cellCapacity : 1024;
+        Point* cells = (Point*)realloc(visibility->cells, capacity * sizeof(Point));
+        if (cells == NULL) return;
+
+        visibility->cells = cells;
+        visibility->cellCapacity = capacity;
+    }
+
+    visibility->cellStamps[index] = visibility->stamp;
+    visibility->cells[visibility->cellCount++] = (Point){ x, y };
+
+    int chunk = (y / visibility->chunkSize) * visibility->chunksX + (x / visibility->chunkSize);
+
+    if (visibility->chunkStamps[chunk] != visibility->stamp)
+    {
+        visibility->chunkStamps[chunk] = visibility->stamp;
+        visibility->chunks[visibility->chunkCount++] = chunk;
+    }
+}
+
+// Cast ray across grid cells until a wall cell (DDA), grid position in cells units (cell x covers [x, x + 1))
+static void CastMazeVisibilityRay(MazeVisibility* visibility, MazeGrid map, Vector2 start, Vector2 direction)
+{
+    int x = (int)floorf(start.x);
+    int y = (int)floorf(start.y);
+    int stepX = (direction.x < 0.0f)? -1 : 1;
+    int stepY = (direction.y < 0.0f)? -1 : 1;
+
+    // Ray length to cross one cell on every axis, and to reach next cell side
+    float deltaX = (direction.x != 0.0f)? fabsf(1.0f / direction.x) : 1e30f;
+    float deltaY = (direction.y != 0.0f)? fabsf(1.0f / direction.y) : 1e30f;
+    float sideX = ((stepX > 0)? (x + 1.0f - start.x) : (start.x - x)) * deltaX;
+    float sideY = ((stepY > 0)? (y + 1.0f - start.y) : (start.y - y)) * deltaY;
+
+    // NOTE: Out-of-bounds cells are walls, every ray stops on map limits or visible range
+    for (int i = 0; i < map.width + map.height; i++)
+    {
+        if ((abs(x - visibility->viewCell.x) > MAZE_VISIBILITY_RANGE) || (abs(y - visibility->viewCell.y) > MAZE_VISIBILITY_RANGE)) break;
+
+        SetMazeCellVisible(visibility, x, y);
+
+        if (IsMazeGridWall(map, x, y)) break;
+
+        if (sideX < sideY)
+        {
+            sideX += deltaX;
+            x += stepX;
+        }
+        else
+        {
+            sideY += deltaY;
+            y += stepY;
+        }
+    }
+}
+
+// Load visibility data for a map size
+MazeVisibility LoadMazeVisibility(int width, int height, int chunkSize)
+{
+    MazeVisibility visibility = { 0 };
+
+    visibility.width = width;
+    visibility.height = height;
+    visibility.chunkSize = chunkSize;
+    visibility.chunksX = (width + chunkSize - 1) / chunkSize;
+    visibility.chunksY = (height + chunkSize - 1) / chunkSize;
+
+    // Cells visible on one update are never further than visible range (and surrounding cells) from view cell,
+    // window wraps them without overlapping
+    visibility.windowWidth = (width < 2*MAZE_VISIBILITY_RANGE + 3)? width : 2*MAZE_VISIBILITY_RANGE + 3;
+    visibility.windowHeight = (height < 2*MAZE_VISIBILITY_RANGE + 3)? height : 2*MAZE_VISIBILITY_RANGE + 3;
+
+    size_t cellCount = (size_t)visibility.windowWidth * visibility.windowHeight;
+    int chunkCount = visibility.chunksX * visibility.chunksY;
+
+    visibility.cellStamps = (unsigned int*)calloc(cellCount, sizeof(unsigned int));
+    visibility.chunkStamps = (unsigned int*)calloc(chunkCount, sizeof(unsigned int));
+    visibility.chunks = (int*)malloc(chunkCount * sizeof(int));
+
+    return visibility;
+}
+
+// Unload visibility data
+void UnloadMazeVisibility(MazeVisibility visibility)
+{
+    free(visibility.cellStamps);
+    free(visibility.chunkStamps);
+    free(visibility.cells);
+    free(visibility.chunks);
+}
+
+// Cast rays over field of view
+// NOTE: Position and direction in world units (map Y axis is world Z axis), rays spread evenly in angle
+void UpdateMazeVisibility(MazeVisibility* visibility, MazeGrid map, Vector2 origin, Vector2 position, Vector2 direction, float fov, int rayCount)
+{
+    if (visibility->cellStamps == NULL) return;
+
+    // New stamp, previous visible cells are not visible anymore
+    visibility->stamp++;
+    if (visibility->stamp == 0)
+    {
+        memset(visibility->cellStamps, 0, (size_t)visibility->windowWidth * visibility->windowHeight * sizeof(unsigned int));
+        memset(visibility->chunkStamps, 0, (size_t)visibility->chunksX * visibility->chunksY * sizeof(unsigned int));
+        visibility->stamp = 1;
+    }
+
+    visibility->cellCount = 0;
+    visibility->chunkCount = 0;
+
+    // Grid position, cell (0, 0) covers [0, 1)
+    Vector2 start = { position.x - origin.x + 0.5f, position.y - origin.y + 0.5f };
+    int cellX = (int)floorf(start.x);
+    int cellY = (int)floorf(start.y);
+    visibility->viewCell = (Point){ cellX, cellY };
+
+    for (int y = cellY - 1; y <= cellY + 1; y++)
+    {
+        for (int x = cellX - 1; x <= cellX + 1; x++) SetMazeCellVisible(visibility, x, y);
+    }
+
+    // View position inside a wall (or out of map), only surrounding cells are visible
+    if (IsMazeGridWall(map, cellX, cellY)) return;
+
+    float angle = atan2f(direction.y, direction.x);
+    if (rayCount < 2) rayCount = 2;
+
+    for (int i = 0; i < rayCount; i++)
+    {
+        float rayAngle = angle - fov / 2.0f + fov * i / (rayCount - 1);
+
+        CastMazeVisibilityRay(visibility, map, start, (Vector2){ cosf(rayAngle), sinf(rayAngle) });
+    }
+}
+
+// Check if cell was visible on last update
+bool IsMazeCellVisible(MazeVisibility visibility, Point cell)
+{
+    if (((unsigned int)cell.x >= (unsigned int)visibility.width) || ((unsigned int)cell.y >= (unsigned int)visibility.height)) return false;
+
+    // Cells out of window around view cell share stamps with visible ones
+    if ((abs(cell.x - visibility.viewCell.x) > MAZE_VISIBILITY_RANGE + 1) || (abs(cell.y - visibility.viewCell.y) > MAZE_VISIBILITY_RANGE + 1)) return false;
+
+    return (visibility.cellStamps[(size_t)(cell.y % visibility.windowHeight) * visibility.windowWidth + (cell.x % visibility.windowWidth)] == visibility.stamp);
+}
+
+#endif // MAZE_VISIBILITY_IMPLEMENTATION